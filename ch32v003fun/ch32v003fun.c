@@ -112,7 +112,28 @@ int wctomb(char *s, wchar_t wc)
 #endif
 size_t strlen(const char *s) { const char *a = s;for (; *s; s++);return s-a; }
 size_t strnlen(const char *s, size_t n) { const char *p = memchr(s, 0, n); return p ? p-s : n;}
-void *memset(void *dest, int c, size_t n) { unsigned char *s = dest; for (; n; n--, s++) *s = c; return dest; }
+/* Word-at-a-time helpers for memset/memcpy/memmove. RV32EC traps on misaligned
+   word accesses, so the word loops only run once both pointers are aligned. */
+typedef uint32_t __attribute__((__may_alias__)) memword_t;
+#define MEMWORD_SIZE sizeof(memword_t)
+#define MEMWORD_MASK (MEMWORD_SIZE-1)
+
+void *memset(void *dest, int c, size_t n)
+{
+	unsigned char *s = dest;
+	memword_t c32 = ((memword_t)-1)/255 * (unsigned char)c;
+
+	for (; n && ((uintptr_t)s & MEMWORD_MASK); n--) *s++ = c;
+	for (; n >= 4*MEMWORD_SIZE; n -= 4*MEMWORD_SIZE, s += 4*MEMWORD_SIZE) {
+		*(memword_t *)(s+0*MEMWORD_SIZE) = c32;
+		*(memword_t *)(s+1*MEMWORD_SIZE) = c32;
+		*(memword_t *)(s+2*MEMWORD_SIZE) = c32;
+		*(memword_t *)(s+3*MEMWORD_SIZE) = c32;
+	}
+	for (; n >= MEMWORD_SIZE; n -= MEMWORD_SIZE, s += MEMWORD_SIZE) *(memword_t *)s = c32;
+	for (; n; n--) *s++ = c;
+	return dest;
+}
 char *strcpy(char *d, const char *s) { for (; (*d=*s); s++, d++); return d; }
 char *strncpy(char *d, const char *s, size_t n) { for (; n && (*d=*s); n--, s++, d++); return d; }
 int strcmp(const char *l, const char *r)
@@ -306,6 +327,18 @@ void *memcpy(void *dest, const void *src, size_t n)
 {
 	unsigned char *d = dest;
 	const unsigned char *s = src;
+
+	if ((((uintptr_t)d ^ (uintptr_t)s) & MEMWORD_MASK) == 0) {
+		for (; n && ((uintptr_t)d & MEMWORD_MASK); n--) *d++ = *s++;
+		for (; n >= 4*MEMWORD_SIZE; n -= 4*MEMWORD_SIZE, d += 4*MEMWORD_SIZE, s += 4*MEMWORD_SIZE) {
+			*(memword_t *)(d+0*MEMWORD_SIZE) = *(const memword_t *)(s+0*MEMWORD_SIZE);
+			*(memword_t *)(d+1*MEMWORD_SIZE) = *(const memword_t *)(s+1*MEMWORD_SIZE);
+			*(memword_t *)(d+2*MEMWORD_SIZE) = *(const memword_t *)(s+2*MEMWORD_SIZE);
+			*(memword_t *)(d+3*MEMWORD_SIZE) = *(const memword_t *)(s+3*MEMWORD_SIZE);
+		}
+		for (; n >= MEMWORD_SIZE; n -= MEMWORD_SIZE, d += MEMWORD_SIZE, s += MEMWORD_SIZE)
+			*(memword_t *)d = *(const memword_t *)s;
+	}
 	for (; n; n--) *d++ = *s++;
 	return dest;
 }
@@ -327,8 +360,20 @@ void *memmove(void *dest, const void *src, size_t n)
 	if ((uintptr_t)s-(uintptr_t)d-n <= -2*n) return memcpy(d, s, n);
 
 	if (d<s) {
+		if ((((uintptr_t)d ^ (uintptr_t)s) & MEMWORD_MASK) == 0) {
+			for (; n && ((uintptr_t)d & MEMWORD_MASK); n--) *d++ = *s++;
+			for (; n >= MEMWORD_SIZE; n -= MEMWORD_SIZE, d += MEMWORD_SIZE, s += MEMWORD_SIZE)
+				*(memword_t *)d = *(const memword_t *)s;
+		}
 		for (; n; n--) *d++ = *s++;
 	} else {
+		if ((((uintptr_t)d ^ (uintptr_t)s) & MEMWORD_MASK) == 0) {
+			while ((uintptr_t)(d+n) & MEMWORD_MASK) {
+				if (!n--) return dest;
+				d[n] = s[n];
+			}
+			while (n >= MEMWORD_SIZE) n -= MEMWORD_SIZE, *(memword_t *)(d+n) = *(const memword_t *)(s+n);
+		}
 		while (n) n--, d[n] = s[n];
 	}
 
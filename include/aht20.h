@@ -6,25 +6,11 @@
 #include "ch32v003fun/ch32v003fun.h"
 #include <stdbool.h>
 #include <stdint.h>
+#include "i2c.h"
 
 // AHT20 I2C address
 #define AHT20_I2C_ADDR 0x38
 
-// I2C Timeout count
-#define TIMEOUT_MAX 100000
-
-// event codes we use
-#define  I2C_EVENT_MASTER_MODE_SELECT 					((uint32_t)0x00030001)  /* BUSY, MSL and SB flag */
-#define  I2C_EVENT_MASTER_TRANSMITTER_MODE_SELECTED 	((uint32_t)0x00070082)  /* BUSY, MSL, ADDR, TXE and TRA flags */
-#define  I2C_EVENT_MASTER_BYTE_TRANSMITTED 				((uint32_t)0x00070084)  /* TRA, BUSY, MSL, TXE and BTF flags */
-#define  I2C_EVENT_MASTER_RECEIVER_MODE_SELECTED        ((uint32_t)0x00030002)  /* BUSY, MSL and ADDR flags */
-
-#define READ 1
-#define WRITE 0
-
-#define ERROR 1
-#define OK 0
-
 
 
 /**
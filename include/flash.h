@@ -5,6 +5,7 @@
 #include <stdint.h>
 #include "ch32v003fun/ch32v003fun.h"
 #include "machineData.h"
+#include "main.h" //USE_RAM_FLASH_ROUTINES, before RAM_FUNCTION below
 
 /* Flash Access Control Register bits */
 #define ACR_LATENCY_Mask           ((uint32_t)0x00000038)
@@ -55,13 +56,40 @@
 #define ValidAddrStart             (FLASH_BASE)
 #define ValidAddrEnd               (FLASH_BASE + 0x4000)
 
-//Use the last 512 bytes of the flash for storing the mileage data
+//Smallest erasable unit
+#define FLASH_PAGE_SIZE 64u
+
+//The flash data areas are kept out of the code by the FLASH length in ch32v003fun/ch32v003fun.ld, change it with them
+//Use the last 256 bytes of the flash for storing the mileage data, see mileageLog.c. A multiple of FLASH_PAGE_SIZE, at least 2 pages
 #define NON_VOLATILE_FLASH_DATA_STORAGE_SIZE 256u
 #define FLASH_ADDR_TO_STORE_BACKUP_DATA (uint16_t*)0x8003F00//0x8003FB0 
+//The job log(jobLog.c) takes the 256 bytes right below. A multiple of FLASH_PAGE_SIZE, at least 2 pages
+#define JOB_LOG_STORAGE_SIZE 256u
+#define FLASH_ADDR_TO_STORE_JOB_LOG (uint16_t*)0x8003E00
+
+/*
+ * The flash stalls every instruction fetch from it while it erases or programs, ~3ms a page. RAM_FUNCTION code
+ * goes to .ramfunc instead, which ch32v003fun.ld puts in .data: copied to RAM at reset and run from there.
+ * Anything it calls has to be RAM_FUNCTION or inline too. Interrupts reach it through a VTF channel(gpioInit()),
+ * the vector table is in flash as well.
+ */
+#if defined(USE_RAM_FLASH_ROUTINES)
+#define RAM_FUNCTION __attribute__((section(".ramfunc"), noinline))
+#else
+#define RAM_FUNCTION
+#endif
 
 /* Exported functions ------------------------------------------------------- */
 FLASH_Status FLASH_WaitForLastOperation(uint32_t Timeout); 
 FLASH_Status FLASH_ProgramHalfWord(uint32_t Address, uint16_t Data);
-void saveMachineMileageDataToFlash(uint16_t* ptrToFlashLocation, uint16_t storageSize, uint16_t sizeOfData);
-uint16_t* findMemoryBlock(uint16_t* ptrToFlashLocation, uint16_t storageSize, uint16_t sizeOfData, bool readOrWrite);
-void getSavedMileageDataFromFlash(uint16_t* ptrToFlashLocation, uint32_t storageSize, uint32_t sizeOfData);
\ No newline at end of file
+void flashUnlock(void);
+void flashErasePage(uint32_t address);
+FLASH_Status flashProgramPage(uint32_t address, const uint32_t *data);
+
+/**
+ * @brief CRC-16/CCITT-FALSE of the records kept in flash.
+ *
+ * @param crc 0xFFFF to start, or the result for the bytes before
+ * @return uint16_t
+ */
+uint16_t crc16(uint16_t crc, const uint8_t *data, uint16_t length);
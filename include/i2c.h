@@ -0,0 +1,65 @@
+#pragma once
+#include "main.h"
+
+#if defined(USE_TEMPERATURE_HUMIDITY_SENSOR) || defined(USE_EXTERNAL_FLASH)
+
+#include "ch32v003fun/ch32v003fun.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// I2C Timeout count
+#define TIMEOUT_MAX 100000
+
+// event codes we use
+#define  I2C_EVENT_MASTER_MODE_SELECT 					((uint32_t)0x00030001)  /* BUSY, MSL and SB flag */
+#define  I2C_EVENT_MASTER_TRANSMITTER_MODE_SELECTED 	((uint32_t)0x00070082)  /* BUSY, MSL, ADDR, TXE and TRA flags */
+#define  I2C_EVENT_MASTER_BYTE_TRANSMITTED 				((uint32_t)0x00070084)  /* TRA, BUSY, MSL, TXE and BTF flags */
+#define  I2C_EVENT_MASTER_RECEIVER_MODE_SELECTED        ((uint32_t)0x00030002)  /* BUSY, MSL and ADDR flags */
+
+#define READ 1
+#define WRITE 0
+
+#define ERROR 1
+#define OK 0
+
+
+
+/**
+ * @brief Performs I2C read or write operation.
+ *
+ * This function sends or receives data over I2C bus based on the provided parameters.
+ *
+ * @param addr The 7-bit I2C address of the device.
+ * @param data Pointer to the data buffer.
+ * @param sz The size of the data buffer. A write of 0 bytes only checks that the device answers its address.
+ * @param rw Specifies whether to perform a read or write operation. Use the READ constant for read operation and WRITE constant for write operation.
+ *
+ * @return Returns 0 on success, or an error code if an error occurred. On a NAK or a timeout the bus is
+ * left stopped, ready for the next transfer.
+ */
+bool i2cReadOrWrite(uint8_t addr, uint8_t *data, uint8_t sz, bool rw);
+
+
+
+/**
+ * @brief Keep the mileage saves off the bus during a transfer.
+ * 
+ * With USE_EXTERNAL_FLASH the mileage is saved over I2C1 from the SysTick(power-off) and PVD(brown-out) interrupts
+ * as well. Anything else holds those two off around each of its transfers, or the save would start in the middle of one.
+ * The mileage checkpoint in the main loop masks them itself.
+ */
+static inline void i2cLock(void) {
+	#if defined(USE_EXTERNAL_FLASH)
+	NVIC_DisableIRQ(SysTicK_IRQn);
+	NVIC_DisableIRQ(PVD_IRQn);
+	#endif
+}
+
+static inline void i2cUnlock(void) {
+	#if defined(USE_EXTERNAL_FLASH)
+	NVIC_EnableIRQ(PVD_IRQn);
+	NVIC_EnableIRQ(SysTicK_IRQn);
+	#endif
+}
+
+#endif
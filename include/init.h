@@ -2,6 +2,7 @@
 
 void init (void);
 void systick_init(void);
+void pvdInit(void);
 void iwdgFeed(void);
 
 
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "flash.h"
+#include "main.h"
+
+/*
+ * Every job that ends(long press on DOWN, see jobEnd_e) leaves a fixed-size record in its own flash area at
+ * FLASH_ADDR_TO_STORE_JOB_LOG, apart from the mileage log. The slots form a ring, the write head is found at boot,
+ * so an append is a few halfword programs and reading a job by its age is one address calculation.
+ * A page is erased only when the head gets to it, so every page wears at the same rate: one erase per
+ * JOB_LOG_SLOTS jobs, FLASH_ENDURANCE_CYCLES * JOB_LOG_SLOTS jobs all together(160000 with the defaults).
+ * A record a power cut tore fails its CRC and shows as a gap, the ones around it are kept.
+ */
+
+#define JOB_LOG_PAGES (JOB_LOG_STORAGE_SIZE / FLASH_PAGE_SIZE)
+//uint8_t like the head and the count, sizeof would make them size_t
+#define JOB_LOG_SLOTS_PER_PAGE ((uint8_t)(FLASH_PAGE_SIZE / sizeof(jobRecord_t)))
+#define JOB_LOG_SLOTS ((uint8_t)(JOB_LOG_PAGES * JOB_LOG_SLOTS_PER_PAGE))
+
+/*One job, 16 bytes*/
+typedef struct {
+	uint16_t sequence;  //Job number, one up every job
+	uint16_t time;      //In minutes
+	uint32_t distance;  //In 0.1m
+	uint16_t endOnTime; //machineOnTimeAge when it ended, in minutes
+	uint8_t maxSpeed;   //In m/min, see speedSample_t
+	uint8_t avgSpeed;   //In m/min
+	uint8_t reason;     //jobEnd_e
+	uint8_t reserved;   //0xFF
+	uint16_t crc;       //CRC-16/CCITT-FALSE of everything above
+} jobRecord_t;
+
+_Static_assert(JOB_LOG_PAGES * (FLASH_PAGE_SIZE / sizeof(jobRecord_t)) <= 255u, "The head and the count are uint8_t");
+
+/*The job jobHistoryScreen shows, all 0 if there is none. Loaded by the main loop on jobHistoryRq*/
+extern jobRecord_t jobHistoryShown;
+
+/**
+ * @brief Find the write head and the number of jobs kept. Once at boot.
+ */
+void jobLogInit(void);
+
+/**
+ * @brief Close a job: write its record into the next slot, erasing the page first if the head just got to it.
+ * Fills in the sequence, reserved and crc. A job with no distance and no time is not logged.
+ * Don't run it while a mileage save may run.
+ *
+ * @param job Distance, time, speeds, endOnTime and reason of the job
+ */
+void jobLogAppend(jobRecord_t *job);
+
+/**
+ * @brief Number of jobs that can be read back.
+ *
+ * @return uint8_t Up to JOB_LOG_SLOTS
+ */
+uint8_t jobLogCount(void);
+
+/**
+ * @brief Read a job back.
+ *
+ * @param age 0 for the last job, 1 for the one before, ...
+ * @param job Where to put it
+ * @return true if there is such a job and its record is intact
+ */
+bool jobLogGet(uint8_t age, jobRecord_t *job);
@@ -21,7 +21,16 @@ typedef enum  {
 } batteryState_e;
 
 /*Screens we got*/
-typedef enum {logoScreen, mainScreenDistance, mainScreenSpeed, temperatureHumidityScreen, settingsScreen, serviceMeScreen, lowBatteryScreen} currentScreen_e;
+typedef enum {logoScreen, mainScreenDistance, mainScreenSpeed, speedChartScreen, temperatureHumidityScreen, settingsScreen, jobHistoryScreen, serviceMeScreen, lowBatteryScreen} currentScreen_e;
+
+/*LCD power states. Idle only slows the screen refresh, sleep blanks the LCD(controller power save)*/
+typedef enum {displayNormal, displayIdle, displaySleep} displayPower_e;
+
+/*Why a job ended, kept in its job log record*/
+typedef enum {
+	jobEndReset,    //Long press on DOWN
+	jobEndTimeFull, //The job time would have wrapped around
+} jobEnd_e;
 
 /*The main chunk of data*/
 typedef struct {
@@ -38,9 +47,18 @@ typedef struct {
 
 	struct visuals{
 		uint8_t backlight; //Backlight brightness
+		uint8_t batteryIcon; //Glyph shown in the top-right corner. The charging blink is an overlay on top of it, see visuals.c
 		currentScreen_e currentScreen;
+		displayPower_e displayPower; //Picked by the SysTick ISR, applied by the main loop
+		uint8_t jobHistoryAge; //Job shown on jobHistoryScreen, 0 for the last one. Stepped with UP
 	}visuals;
 
+	struct endedJob {
+		uint32_t distance; //In 0.1m
+		uint16_t time; //In minutes
+		uint8_t reason; //jobEnd_e
+	}endedJob; //The counters as they were when newJobRq was set, for the job log
+
 	struct flags{
 		uint8_t batteryNeedsMeasuring:1;
 		uint8_t screenNeedsUpdating:1;
@@ -52,10 +70,29 @@ typedef struct {
 		uint8_t temperatureAndHumidityNeedsMeasuring:1;
 		//uint8_t :0;
 	}flags;
+
+	/*Set by the ISRs, done and cleared by the main loop. A byte each, clearing one is a single store and can't
+	  write back a request an interrupt raised in between, as it could in the flags bitfield*/
+	struct requests{
+		volatile uint8_t speedNeedsSample;
+		volatile uint8_t newJobRq; //Job ended(endedJob), log it and restart the job speed statistics
+		volatile uint8_t checkpointRq; //Mileage checkpoint due, see CHECKPOINT_DISTANCE and CHECKPOINT_TIME
+		volatile uint8_t jobHistoryRq; //Load the job at jobHistoryAge for jobHistoryScreen
+	}requests;
 }machineData_t;
 extern machineData_t machineData; // volatile
 
-/*To store the machine mileage. It should be defined in .noinit region to prevent it from losing after reset*/
+/*Screen refresh counters, to tune SCREEN_MIN_FRAME_INTERVAL and SCREEN_KEEP_ALIVE_PERIOD per machine. Read them with the debugger*/
+typedef struct {
+	uint32_t frames; //Frames drawn since power up
+	uint32_t frameCycles; //CPU cycles(HCLK) the last frame took
+	uint32_t frameCyclesMax; //Slowest frame since power up
+	uint8_t framesPerSecond; //Frames drawn during the last second
+	uint8_t cpuLoad; //In %, share of the last second spent drawing
+}screenStats_t;
+extern screenStats_t screenStats;
+
+/*To store the machine mileage. Kept in flash(mileageLog.c), and through a warm reset in a .noinit copy*/
 typedef struct {
 	uint32_t machineMileage; //In 0.1m 
 	uint32_t currentDistance; //In 0.1m
@@ -7,11 +7,20 @@
 #include <string.h>
 
 /*--------------------------------------------------------------Options list--------------------------------------------------------------*/
+//RAM is 2KB. The 1KB frame buffer, the RAM routines, the speed history and a stack that is deep enough don't all fit,
+//the link fails when the stack headroom is short(end of ch32v003fun/ch32v003fun.ld). tools/ram/ramreport.sh estimates it
 #define USE_TEMPERATURE_HUMIDITY_SENSOR
-// #define USE_EXTERNAL_FLASH
+#define USE_SPEED_CHART //Speed trend screen, drawn from the speed history. Its 1s tier grows to the chart width, the 10s and 1min tiers get shorter for it
+#define USE_RAM_FLASH_ROUTINES //Run the flash erase/program routines and the encoder interrupt from RAM, so no wheel pulse waits for a checkpoint. ~300 bytes of RAM
+// #define USE_EXTERNAL_FLASH //Keep the mileage in a 24Cxx EEPROM or FRAM on I2C1 instead of the internal flash, see External storage below
+// #define USE_PRERENDERED_BACKGROUNDS //Unpack screen labels from lcd/backgrounds.h instead of drawing them. ~450 bytes more flash, 8-23x faster screen switch
+//-DGLCD_USE_STRIP_BUFFER in the build_flags of platformio.ini keeps one 128 byte LCD page in RAM instead of the 1KB frame buffer(glcd_buffer in the .map). Redraws the screen once per changed page.
+//A build flag and not an option here, so lcd/ sees it without this header
+// #define USE_SEGMENT_DIGITS_SPEED //Draw the big speed readout as seven-segment digits instead of Calibri23x38. Only the changed digits get redrawn
+// #define USE_SEGMENT_DIGITS_DISTANCE //Same for the big distance readout. With both, Calibri23x38 is left out of the build(~920 bytes flash)
 
 /*--------------------------------------------------------------Battery stuff--------------------------------------------------------------*/
-#define BATTERY_CHARGING_BLINK_PERIOD_DIVIDER 5u
+#define BATTERY_CHARGING_BLINK_PERIOD 1024u //In ms. Power of two, the icon toggles on that bit of sysTickCnt
 #define BATTERY_CHARGING_OFFSET_VOLTAGE 100u //In mV
 //Battery voltage levels
 #define BATTERY_FLAT       2370u //In mV
@@ -21,10 +30,24 @@
 #define BATTERY_80_PERCENT 2700u //In mV
 
 /*--------------------------------------------------------------Timings--------------------------------------------------------------*/
-#define SCREEN_UPDATE_PERIOD 200u
+#define SCREEN_MIN_FRAME_INTERVAL 50u //In ms. Fastest refresh while the shown values are changing(20Hz)
+#define SCREEN_KEEP_ALIVE_PERIOD 1000u //In ms. Refresh anyway when nothing watched has changed
+/*
+ * LCD power states, counted from the last wheel pulse or button press with the backlight off. Charging keeps it normal.
+ * Normal: controller on with its booster, refresh as above. Low hundreds of uA for the LCD module(datasheet order of magnitude, measure on the board).
+ * Idle: controller as in normal, refresh slowed to the two periods below. The ST7567 has no partial display or frame
+ *       rate setting and needs its booster for any picture, so the saving is SPI traffic and CPU time.
+ * Sleep: controller power save(display off + all points on), a few uA. Blank. Back with the old picture on any activity.
+ */
+#define DISPLAY_IDLE_TIMEOUT 10000u //In ms
+#define DISPLAY_SLEEP_TIMEOUT 120000u //In ms. Keep below GO_TO_SLEEP_TIMEOUT, which switches everything off
+#define SCREEN_IDLE_FRAME_INTERVAL 1000u //In ms
+#define SCREEN_IDLE_KEEP_ALIVE_PERIOD 10000u //In ms. Longer than the watchdog period(about 8.2s, init.c), which is why mainLoop()
+//feeds it every pass and not per frame. Whatever ties the feed to frames has to keep this under the watchdog period
 #define GO_TO_SLEEP_TIMEOUT 180000u
 #define BATTERY_VOLTAGE_MEASURING_PERIOD 60000u
 #define TEMPERATURE_AND_HIMIDITY_MEASURING_PERIOD 30000u
+#define SPEED_SAMPLE_PERIOD 1000u //In ms. Speed history(src/speedHistory.c) and chart sample rate. The history tiers are named for 1s
 #define MS_IN_1_MINUTE  60000ul 
 #define SPEED_SET_TO_ZERO_TIMEOUT 1024u //In ms
 #define SHORT_PRESS_TIME 4u
@@ -37,12 +60,70 @@
 #define MACHINE_SERVICE_WARNING_MESSAGE_SHOW_WHEN 1000*10 //In m
 #define BROKEN_SENSOR_READING 0
 
+/*
+ * Mileage checkpoints. Besides the save at power-off, the mileage is saved every CHECKPOINT_DISTANCE of travel or
+ * CHECKPOINT_TIME of on time, whichever comes first(see include/mileageLog.h). Both are worked out from these,
+ * so the log runs out of erase cycles no sooner than the machine reaches its design life.
+ */
+#define FLASH_ENDURANCE_CYCLES 10000u //Erase cycles per flash page, CH32V003 datasheet
+#define MACHINE_DESIGN_LIFE_DISTANCE 20000u //In km
+#define MACHINE_DESIGN_LIFE_ON_TIME 20000u //In hours
+#define MILEAGE_LOG_SAVES_PER_ERASE 4u //Snapshot and deltas one page takes. ~4.7 measured, worst case 2
+/*
+ * Brown-out save. VDD is 3.0V from the boost converter(ADC_REF_VOLTAGE). When the battery gets below its dropout,
+ * or a short cuts it off, VDD follows the battery down and the PVD interrupt saves the mileage before the MCU stops.
+ * 2.9V, the lowest level, is the first one under VDD: any higher and the PVD would never clear after power up.
+ * The save has to fit between the PVD trip and the MCU brown-out reset. Measure that hold-up time on the board
+ * (the bulk capacitance after the boost and the 3V rail current with the LCD and backlight off) and compare it with
+ * mileageLogStats.brownOutCycles.
+ * The level is only 0.1V under VDD, a backlight PWM edge or an LCD refresh can dip through it. The interrupt cuts the
+ * backlight and checks PVDO again after PVD_DEBOUNCE_TIME. That is taken off the hold-up time, keep it short.
+ */
+#define PVD_LEVEL PWR_PVDLevel_2V9
+#define PVD_DEBOUNCE_TIME 20u //In us
+
+/*
+ * External storage(USE_EXTERNAL_FLASH), see include/storage.h. A ring of EXTERNAL_STORAGE_SLOTS records from address 0,
+ * one per EXTERNAL_STORAGE_PAGE_SIZE slot. A record takes 24 bytes and an EEPROM has to write it in one page, so 32 byte
+ * pages and up: 24C32 and bigger, two address bytes. The defaults are for a 24C32(4KB), the ring takes the first 2KB.
+ * With an FRAM(FM24CLxx, MB85RCxx) define EXTERNAL_STORAGE_FRAM: no pages, no write cycle to wait for and no wear to
+ * budget for. The ones up to 2KB take one address byte with the block number in the device address.
+ * An EEPROM write waits for the one before it to finish(ACK polling, EXTERNAL_STORAGE_WRITE_TIME at most), only a
+ * brown-out save right after another save takes that much more of the hold-up time.
+ */
+// #define EXTERNAL_STORAGE_FRAM
+#define EXTERNAL_STORAGE_I2C_ADDR 0x50u
+#define EXTERNAL_STORAGE_ADDRESS_BYTES 2u
+#define EXTERNAL_STORAGE_PAGE_SIZE 32u //In bytes, one slot
+#define EXTERNAL_STORAGE_SLOTS 64u
+#define EXTERNAL_STORAGE_ENDURANCE_CYCLES 1000000u //Write cycles per EEPROM page
+#define EXTERNAL_STORAGE_WRITE_TIME 5u //In ms, EEPROM page write cycle, the longest the ACK polling waits
+
+//Speed history tiers, 1 byte per 1s sample and 3 bytes(min/max/avg) per slot, 32 bytes of heads and sums on top.
+//SPEED_HISTORY_RAM_BUDGET all together, src/speedHistory.c checks it. The chart takes a 1s tier as wide as itself, so the coarser tiers are shorter with it
+#define SPEED_HISTORY_RAM_BUDGET 256u
+#if defined(USE_SPEED_CHART)
+#define SPEED_HISTORY_1S_SLOTS   SPEED_CHART_WIDTH //Last 2m08s, the speed chart draws them
+#define SPEED_HISTORY_10S_SLOTS  16u //Last 2m40s
+#define SPEED_HISTORY_1MIN_SLOTS 16u //Last 16 minutes
+#else
+#define SPEED_HISTORY_1S_SLOTS   60u //Last minute
+#define SPEED_HISTORY_10S_SLOTS  28u //Last 4m40s
+#define SPEED_HISTORY_1MIN_SLOTS 26u //Last 26 minutes
+#endif
+
 #define FUNNY_PRESSES_SPEED_TO_FACTORY_RESET    100 //Need to press buttons every 50ms
 #define FUNNY_PRESSES_TO_FACTORY_RESET  300u
 
 /*--------------------------------------------------------------LCD--------------------------------------------------------------*/
+#if defined(GLCD_USE_STRIP_BUFFER)
+#define LCD_FRAME_BUFFER_SIZE 128u
+#else
 #define LCD_FRAME_BUFFER_SIZE 1024u
-#define NB_OF_SCREENS 5u
+#endif
+#define NB_OF_SCREENS 7u
+#define SPEED_CHART_FULL_SCALE 100u //In m/min, speed at the top of the speed chart
+#define SPEED_CHART_WIDTH 128u //In columns, one per 1s speed sample
 #define BACKLIGHT_BRIGHTNESS 255u
 
 /*--------------------------------------------------------------ADC--------------------------------------------------------------*/
@@ -104,7 +185,9 @@ extern uint8_t glcd_buffer[LCD_FRAME_BUFFER_SIZE];
 extern uint32_t cntToZeroTheSpeedDisplay;
 extern uint32_t cntToSleep;
 extern uint32_t cntToMeasureBattery;
-extern uint32_t cntToUpdateScreen;
+extern uint32_t cntToSampleSpeed;
+extern uint32_t cntToNextFrame;
+extern uint32_t cntToScreenKeepAlive;
 /*--------------------------------------------------------------Exported functions--------------------------------------------------------------*/
 extern void goToSleep (void);
 
@@ -115,7 +198,7 @@ extern void goToSleep (void);
 * Unit:1 °C
 *
 */
-const static int NTC_table[33] = {
+static const int NTC_table[33] = {
   -54, -45, -36, -29, -24, -20, -17, -13, -10, 
   -8, -5, -2, 0, 3, 5, 8, 10, 13, 15, 18, 21, 
   24, 27, 31, 35, 39, 44, 49, 56, 66, 79, 104, 
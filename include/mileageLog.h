@@ -0,0 +1,77 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "machineData.h"
+#include "storage.h"
+#include "main.h"
+
+/*
+ * The mileage is saved at power-off, on a brown-out(PVD interrupt) and on checkpoints in between, into one of the
+ * storage backends(include/storage.h). The flash or the external memory is only read on power up. A copy of
+ * mileageData, the job counters and the write head is kept in .noinit RAM with a CRC, refreshed from SysTick,
+ * and a watchdog or software reset carries on from there.
+ */
+
+#if defined(STORAGE_UNLIMITED_ENDURANCE)
+/*No budget to keep to, every wheel pulse and every minute is a checkpoint*/
+#define CHECKPOINT_DISTANCE 0u
+#define CHECKPOINT_TIME 0u
+#else
+/*
+ * Checkpoint budget: every save the storage can take before it is worn out(STORAGE_SAVES_BUDGET). Half of it goes to
+ * distance checkpoints over MACHINE_DESIGN_LIFE_DISTANCE, the other half to time checkpoints and
+ * power-offs over MACHINE_DESIGN_LIFE_ON_TIME. With the defaults: internal flash 160000 saves, every 250m or
+ * 15min, a 24C32 EEPROM 64 million, every 1m or 1min.
+ */
+#define CHECKPOINT_DISTANCE (((uint32_t)MACHINE_DESIGN_LIFE_DISTANCE * 1000u * 2 + STORAGE_SAVES_BUDGET - 1) / STORAGE_SAVES_BUDGET) //In m, rounded up
+#define CHECKPOINT_TIME (((uint32_t)MACHINE_DESIGN_LIFE_ON_TIME * 60u * 2 + STORAGE_SAVES_BUDGET - 1) / STORAGE_SAVES_BUDGET) //In minutes, rounded up
+#endif
+
+/*Save timing, to check what a checkpoint costs on the machine. Read them with the debugger, wear is on the settings screen*/
+typedef struct {
+	uint32_t saves;
+	uint32_t pageWrites;   //Internal flash: saves that opened a page with a snapshot, with flashProgramPage()
+	uint32_t saveCycles;   //HCLK cycles(SysTick->CNT) the last save took, interrupts included
+	uint32_t saveCyclesMax;
+	uint32_t brownOutSaves;
+	uint32_t brownOutCycles; //HCLK cycles the last brown-out save took. Has to fit in the hold-up time, see PVD_LEVEL
+	uint8_t wear;          //Endurance of the storage used up since it was first written, in %
+} mileageLogStats_t;
+extern mileageLogStats_t mileageLogStats;
+
+/**
+ * @brief Read the newest record into mileageData and machineData(storageReadLatest()).
+ * Falls back to a fresh machine if there is none.
+ */
+void getSavedMileageDataFromFlash(void);
+
+/**
+ * @brief After a watchdog, software, pin or low-power reset, take mileageData, the job counters and the write head from the
+ * .noinit copy. Call before getSavedMileageDataFromFlash(), which is only needed if this fails.
+ *
+ * @return true if restored. false on power up, or if the copy fails its magic or CRC
+ */
+bool restoreMileageDataFromRam(void);
+
+/**
+ * @brief Refresh the .noinit copy for restoreMileageDataFromRam(). Compares ~60 bytes, the CRC only if anything
+ * changed. Call from SysTick, not while a save is running.
+ */
+void mileageLogSealWarmState(void);
+
+/**
+ * @brief Append the current mileage to the storage. O(1), the write head is cached since boot.
+ */
+void saveMachineMileageDataToFlash(void);
+
+/**
+ * @brief Save from the PVD interrupt, the supply is going, with storageAppendUrgent().
+ */
+void saveMachineMileageDataOnBrownOut(void);
+
+/**
+ * @brief Is a checkpoint due: CHECKPOINT_DISTANCE travelled or CHECKPOINT_TIME on since the last save, with
+ * unlimited endurance any change. Two subtractions, cheap enough for the SysTick interrupt.
+ */
+bool mileageLogCheckpointDue(void);
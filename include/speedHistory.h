@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "main.h"
+
+/*
+ * Speed history in three tiers. Every second one 1-byte sample goes into the 1s tier, every 10 samples
+ * make a 10s slot and every 6 of those a 1min slot. Each slot keeps min/max/average of the 1s samples
+ * it covers, built up as they come in, so adding a sample is O(1) and nothing is ever rescanned.
+ */
+
+/*Speed over one slot of a tier, in m/min. Backwards counts as 0, anything over 255 as 255*/
+typedef struct {
+	uint8_t min;
+	uint8_t max;
+	uint8_t avg;
+} speedSample_t;
+
+/*History tiers, each one fed by the one before*/
+typedef enum {
+	speedTier1s,   //The samples themselves, min = max = avg
+	speedTier10s,
+	speedTier1min,
+	SPEED_HISTORY_TIERS
+} speedTier_e;
+
+/**
+ * @brief Add the speed sample of the last second to the history and the job statistics.
+ *
+ * @param speed Speed in m/min
+ */
+void speedHistoryAdd(int16_t speed);
+
+/**
+ * @brief Read a slot of a tier.
+ *
+ * @param tier History tier
+ * @param age 0 for the newest complete slot, 1 for the one before, ...
+ * @param sample Where to put it
+ * @return true if there is such a slot
+ */
+bool speedHistoryGet(speedTier_e tier, uint8_t age, speedSample_t *sample);
+
+/**
+ * @brief Start a new job. The history tiers are kept, the job statistics start over.
+ */
+void speedHistoryResetJob(void);
+
+/**
+ * @brief Speed statistics of the current job.
+ *
+ * @param stats Min/max/average of every sample since the job started. All 0 before the first one
+ * @return uint32_t Number of samples(seconds) in the job
+ */
+uint32_t speedHistoryGetJobStats(speedSample_t *stats);
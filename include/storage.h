@@ -0,0 +1,96 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "machineData.h"
+#include "flash.h"
+#include "main.h"
+
+/*
+ * Where the mileage records are kept. mileageLog.c decides when to save, one of two backends picked at build time
+ * does the saving, behind the same calls: append a record, read the latest one back, erase them all.
+ *
+ * Internal flash(src/storageFlash.c), the default. An append-only log of records in the flash area at
+ * FLASH_ADDR_TO_STORE_BACKUP_DATA. Every page starts with a snapshot, a header and a full copy of mileageData_t.
+ * The rest of the page is filled with delta records against that snapshot: a length byte, a CRC-16 and five varints,
+ * usually 8 bytes instead of 24. Boot replays the deltas of the newest page and keeps the last good one. Records never
+ * straddle a flash page. A record that a power cut tore, or that got corrupted later, fails its CRC and the one before
+ * it is used instead. The pages form a ring: only the page after the write head's, the one with the oldest records,
+ * is erased. That is done right after every save, so a brown-out save finds it ready(storageAppendUrgent()).
+ * The others keep their records through a power cut at any point, and every page wears at the same rate.
+ * More pages(NON_VOLATILE_FLASH_DATA_STORAGE_SIZE) means proportionally fewer erases per page.
+ *
+ * External EEPROM or FRAM(src/storageI2c.c), with USE_EXTERNAL_FLASH. A 24Cxx on I2C1 holds a ring of
+ * EXTERNAL_STORAGE_SLOTS fixed-size records, one per EXTERNAL_STORAGE_PAGE_SIZE page, each written with a single
+ * page write. No erase, no deltas: a record goes over the oldest one, a torn one fails its CRC. An EEPROM wears one
+ * page per lap of the ring. An FRAM does not wear out for any practical purpose(EXTERNAL_STORAGE_FRAM), the mileage
+ * is then saved on every wheel pulse.
+ */
+
+#if defined(USE_EXTERNAL_FLASH)
+#if defined(EXTERNAL_STORAGE_FRAM)
+#define STORAGE_UNLIMITED_ENDURANCE
+#endif
+#define STORAGE_SAVES_BUDGET ((uint32_t)EXTERNAL_STORAGE_ENDURANCE_CYCLES * EXTERNAL_STORAGE_SLOTS)
+
+/*What a warm restart needs to carry on with the ring, see storageGetState()*/
+typedef struct {
+	uint32_t nextSequence;
+	uint8_t head; //Slot written next
+} storageState_t;
+
+#else
+#define MILEAGE_RECORD_MAGIC 0x4D4Cu //"ML"
+#define MILEAGE_LOG_PAGES (NON_VOLATILE_FLASH_DATA_STORAGE_SIZE / FLASH_PAGE_SIZE)
+#define STORAGE_SAVES_BUDGET ((uint32_t)FLASH_ENDURANCE_CYCLES * MILEAGE_LOG_PAGES * MILEAGE_LOG_SAVES_PER_ERASE)
+
+typedef struct {
+	uint16_t magic;    //MILEAGE_RECORD_MAGIC
+	uint16_t sequence; //One up every save, wraps around
+	uint16_t length;   //Payload bytes following the header
+	uint16_t crc;      //CRC-16/CCITT-FALSE of sequence, length and payload
+} mileageRecordHeader_t;
+
+/*What a warm restart needs to carry on with the log, see storageGetState()*/
+typedef struct {
+	mileageData_t snapshot; //The one the deltas of the head's page are taken against
+	uint16_t writeOffset;   //Byte offset into the area
+	uint16_t nextSequence;
+} storageState_t;
+#endif
+
+/**
+ * @brief Find the newest record and cache the write head. Once at boot.
+ *
+ * @param data Where to put the mileage it holds
+ * @return true if there is one. If not, start over with storageErase()
+ */
+bool storageReadLatest(mileageData_t *data);
+
+/**
+ * @brief Append a record. O(1), the write head is cached.
+ */
+void storageAppend(const mileageData_t *data);
+
+/**
+ * @brief Append a record from the PVD interrupt, the supply is going. As short as the backend can make it: internal
+ * flash puts a full snapshot into the next page, which every other save leaves erased, so it is one page programming
+ * cycle and no erase. A cut during it leaves a record that fails its CRC, and the last good one before it is used.
+ */
+void storageAppendUrgent(const mileageData_t *data);
+
+/**
+ * @brief Erase every record, the next append starts the area over.
+ */
+void storageErase(void);
+
+/**
+ * @brief The write head and whatever else the backend caches, for the .noinit copy in mileageLog.c.
+ * Fills in the fields one by one, the padding is left as the caller set it.
+ */
+void storageGetState(storageState_t *state);
+
+/**
+ * @brief Carry on from storageGetState() instead of storageReadLatest() after a warm restart.
+ */
+void storageSetState(const storageState_t *state);
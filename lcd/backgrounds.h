@@ -0,0 +1,162 @@
+/*
+ * Packed power-up logo and pre-rendered static layers of the table driven screens, see glcd_draw_packed_bitmap().
+ * Generated by tools/backgrounds/mkbackgrounds.sh from the tables in lcd/visuals.c. Do not edit.
+ */
+#pragma once
+
+#include <stdint.h>
+
+/*logo: 1024 -> 275 bytes*/
+static const uint8_t logoBackground[] = {
+	0xFF, 0x00, 0x9B, 0x00, 0x02, 0xFC, 0xF8, 0xFC, 0x83, 0x0C, 0x03, 0x08, 0x18, 0x30, 0xE0, 0x84,
+	0x00, 0x80, 0xFC, 0x82, 0x00, 0x05, 0x80, 0xC0, 0x60, 0x18, 0x0C, 0x04, 0x83, 0x00, 0x01, 0xF8,
+	0xFC, 0x86, 0x0C, 0x84, 0x00, 0x01, 0xF8, 0xFC, 0x83, 0x0C, 0x80, 0x08, 0x04, 0x18, 0x10, 0x30,
+	0xE0, 0x80, 0xBD, 0x00, 0x81, 0xFF, 0x82, 0x30, 0x80, 0x10, 0x02, 0x18, 0x0C, 0x07, 0x84, 0x00,
+	0x80, 0xFF, 0x05, 0x00, 0x08, 0x1C, 0x63, 0xC1, 0x80, 0x87, 0x00, 0x80, 0xFF, 0x85, 0x18, 0x85,
+	0x00, 0x80, 0xFF, 0x89, 0x00, 0x00, 0xFF, 0xBD, 0x00, 0x81, 0x3F, 0x8D, 0x00, 0x80, 0x3F, 0x83,
+	0x00, 0x04, 0x01, 0x07, 0x0C, 0x18, 0x30, 0x83, 0x00, 0x01, 0x1F, 0x3F, 0x86, 0x30, 0x84, 0x00,
+	0x01, 0x1F, 0x3F, 0x83, 0x30, 0x80, 0x10, 0x04, 0x18, 0x08, 0x0C, 0x07, 0x01, 0xFF, 0x00, 0xA5,
+	0x00, 0x80, 0x20, 0x83, 0x00, 0x80, 0x80, 0x82, 0x00, 0x80, 0x80, 0x82, 0x00, 0x80, 0x80, 0x82,
+	0x00, 0x80, 0x80, 0x88, 0x00, 0x81, 0x20, 0x87, 0x00, 0x80, 0x80, 0x81, 0x00, 0x80, 0x80, 0x81,
+	0x00, 0x80, 0x80, 0x84, 0x00, 0x80, 0x80, 0x82, 0x00, 0x80, 0x80, 0x82, 0x00, 0x80, 0x80, 0x86,
+	0x00, 0x00, 0x80, 0x81, 0x00, 0x00, 0x80, 0x82, 0x00, 0x80, 0x80, 0x81, 0x00, 0x80, 0x80, 0x81,
+	0x00, 0x80, 0x80, 0x83, 0x00, 0x00, 0x80, 0x8A, 0x00, 0x01, 0x11, 0x10, 0x83, 0x00, 0x80, 0x10,
+	0x81, 0x00, 0x09, 0x02, 0x12, 0x12, 0x02, 0x00, 0x00, 0x02, 0x12, 0x12, 0x02, 0x81, 0x00, 0x80,
+	0x10, 0x88, 0x00, 0x81, 0x10, 0x86, 0x00, 0x81, 0x10, 0x82, 0x00, 0x00, 0x10, 0x81, 0x00, 0x80,
+	0x12, 0x00, 0x02, 0x89, 0x00, 0x80, 0x10, 0x81, 0x00, 0x03, 0x02, 0x12, 0x12, 0x02, 0x8D, 0x00,
+	0x03, 0x02, 0x12, 0x12, 0x02, 0x81, 0x00, 0x06, 0x10, 0x00, 0x00, 0x02, 0x12, 0x12, 0x02, 0xFF,
+	0x00, 0x87, 0x00,
+};
+
+#if defined(USE_PRERENDERED_BACKGROUNDS)
+
+/*mainScreenDistance: 1024 -> 130 bytes*/
+static const uint8_t mainScreenDistanceBackground[] = {
+	0x83, 0x00, 0x0C, 0x7F, 0x41, 0x41, 0x22, 0x1C, 0x00, 0x00, 0x44, 0x7D, 0x40, 0x00, 0x00, 0x48,
+	0x81, 0x54, 0x08, 0x20, 0x00, 0x04, 0x3F, 0x44, 0x40, 0x20, 0x00, 0x20, 0x81, 0x54, 0x08, 0x78,
+	0x00, 0x7C, 0x08, 0x04, 0x04, 0x78, 0x00, 0x38, 0x81, 0x44, 0x02, 0x20, 0x00, 0x38, 0x81, 0x54,
+	0x00, 0x18, 0x85, 0x00, 0x08, 0x7C, 0x04, 0x18, 0x04, 0x78, 0x00, 0x00, 0x36, 0x36, 0xFF, 0x00,
+	0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0x09, 0x00, 0x08, 0x08, 0xF8, 0x08,
+	0x08, 0x00, 0x00, 0x20, 0xE8, 0x81, 0x00, 0x06, 0xE0, 0x20, 0xC0, 0x20, 0xC0, 0x00, 0xC0, 0x81,
+	0xA0, 0x04, 0xC0, 0x00, 0x00, 0xB0, 0xB0, 0xE5, 0x00, 0x00, 0x03, 0x82, 0x00, 0x05, 0x02, 0x03,
+	0x02, 0x00, 0x00, 0x03, 0x81, 0x00, 0x02, 0x03, 0x00, 0x01, 0x81, 0x02, 0x81, 0x00, 0x80, 0x01,
+	0x98, 0x00,
+};
+
+/*mainScreenSpeed: 1024 -> 235 bytes*/
+static const uint8_t mainScreenSpeedBackground[] = {
+	0x8B, 0x00, 0x00, 0x46, 0x81, 0x49, 0x02, 0x31, 0x00, 0x7C, 0x81, 0x14, 0x02, 0x08, 0x00, 0x38,
+	0x81, 0x54, 0x02, 0x18, 0x00, 0x38, 0x81, 0x54, 0x0A, 0x18, 0x00, 0x38, 0x44, 0x44, 0x48, 0x7F,
+	0x00, 0x00, 0x36, 0x36, 0x91, 0x00, 0x80, 0xFF, 0xFC, 0x00, 0x80, 0xFF, 0x8E, 0x00, 0x80, 0x02,
+	0x10, 0xFE, 0x02, 0x02, 0x00, 0x00, 0x88, 0xFA, 0x80, 0x00, 0x00, 0xF8, 0x08, 0x30, 0x08, 0xF0,
+	0x00, 0x70, 0x81, 0xA8, 0x04, 0x30, 0x00, 0x00, 0x6C, 0x6C, 0xD1, 0x00, 0x80, 0xFF, 0xFC, 0x00,
+	0x80, 0xFF, 0xFC, 0x00, 0x80, 0xFF, 0x84, 0x06, 0x03, 0xC6, 0x46, 0x46, 0x86, 0x82, 0x06, 0x00,
+	0x46, 0x88, 0x06, 0x00, 0xC6, 0x9B, 0x06, 0x80, 0x86, 0x82, 0x06, 0xBF, 0x00, 0x80, 0xFF, 0x84,
+	0x00, 0x0C, 0x1F, 0x10, 0x10, 0x08, 0x07, 0x00, 0x00, 0x11, 0x1F, 0x10, 0x00, 0x00, 0x12, 0x81,
+	0x15, 0x08, 0x08, 0x00, 0x01, 0x0F, 0x11, 0x10, 0x08, 0x00, 0x08, 0x81, 0x15, 0x08, 0x1E, 0x00,
+	0x1F, 0x02, 0x01, 0x01, 0x1E, 0x00, 0x0E, 0x81, 0x11, 0x02, 0x08, 0x00, 0x0E, 0x81, 0x15, 0x04,
+	0x06, 0x00, 0x00, 0x0D, 0x0D, 0x8F, 0x00, 0x14, 0xF0, 0x10, 0x60, 0x10, 0xE0, 0x00, 0x80, 0x40,
+	0x20, 0x10, 0x08, 0x00, 0xF0, 0x10, 0x60, 0x10, 0xE0, 0x00, 0x00, 0x10, 0xF4, 0x81, 0x00, 0x04,
+	0xF0, 0x20, 0x10, 0x10, 0xE0, 0x95, 0x00, 0x80, 0xFF, 0xC8, 0x00, 0x00, 0x01, 0x81, 0x00, 0x00,
+	0x01, 0x85, 0x00, 0x00, 0x01, 0x81, 0x00, 0x02, 0x01, 0x00, 0x00, 0x81, 0x01, 0x80, 0x00, 0x00,
+	0x01, 0x81, 0x00, 0x00, 0x01, 0x95, 0x00, 0x80, 0xFF, 0xBB, 0x00,
+};
+
+/*speedChartScreen: 1024 -> 50 bytes*/
+static const uint8_t speedChartScreenBackground[] = {
+	0x00, 0x46, 0x81, 0x49, 0x02, 0x31, 0x00, 0x7C, 0x81, 0x14, 0x02, 0x08, 0x00, 0x38, 0x81, 0x54,
+	0x02, 0x18, 0x00, 0x38, 0x81, 0x54, 0x0A, 0x18, 0x00, 0x38, 0x44, 0x44, 0x48, 0x7F, 0x00, 0x00,
+	0x36, 0x36, 0xDD, 0x00, 0xFE, 0x40, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00,
+	0xF9, 0x00,
+};
+
+/*temperatureHumidityScreen: 1024 -> 216 bytes*/
+static const uint8_t temperatureHumidityScreenBackground[] = {
+	0xFE, 0x00, 0x83, 0x80, 0xA4, 0x00, 0x00, 0x80, 0xA2, 0x00, 0x00, 0x80, 0x81, 0x00, 0x00, 0x80,
+	0x8D, 0x00, 0x00, 0x80, 0x85, 0x00, 0x00, 0x80, 0x81, 0x00, 0x00, 0x80, 0x82, 0x00, 0x00, 0x80,
+	0x8A, 0x00, 0x00, 0x3F, 0x81, 0x00, 0x00, 0x1C, 0x81, 0x2A, 0x08, 0x0C, 0x00, 0x3E, 0x02, 0x0C,
+	0x02, 0x3C, 0x00, 0x3E, 0x81, 0x0A, 0x02, 0x04, 0x00, 0x1C, 0x81, 0x2A, 0x08, 0x0C, 0x00, 0x3E,
+	0x04, 0x02, 0x02, 0x04, 0x00, 0x10, 0x81, 0x2A, 0x14, 0x3C, 0x00, 0x02, 0x1F, 0x22, 0x20, 0x10,
+	0x00, 0x1E, 0x20, 0x20, 0x10, 0x3E, 0x00, 0x3E, 0x04, 0x02, 0x02, 0x04, 0x00, 0x1C, 0x81, 0x2A,
+	0x00, 0x0C, 0x8D, 0x00, 0x00, 0x3F, 0x81, 0x04, 0x26, 0x3F, 0x00, 0x1E, 0x20, 0x20, 0x10, 0x3E,
+	0x00, 0x3E, 0x02, 0x0C, 0x02, 0x3C, 0x00, 0x00, 0x22, 0x3E, 0x20, 0x00, 0x00, 0x1C, 0x22, 0x22,
+	0x24, 0x3F, 0x00, 0x00, 0x22, 0x3E, 0x20, 0x00, 0x00, 0x02, 0x1F, 0x22, 0x20, 0x10, 0x00, 0x06,
+	0x81, 0x28, 0x00, 0x1E, 0x82, 0x00, 0x00, 0xE0, 0xAE, 0x20, 0x00, 0xE0, 0x99, 0x00, 0x00, 0xE0,
+	0xA4, 0x20, 0x00, 0xE0, 0x89, 0x00, 0x00, 0xFF, 0xAE, 0x00, 0x00, 0xFF, 0x99, 0x00, 0x00, 0xFF,
+	0xA4, 0x00, 0x00, 0xFF, 0x89, 0x00, 0x00, 0xFF, 0xAE, 0x00, 0x00, 0xFF, 0x99, 0x00, 0x00, 0xFF,
+	0xA4, 0x00, 0x00, 0xFF, 0x89, 0x00, 0x00, 0x3F, 0xAE, 0x20, 0x00, 0x3F, 0x99, 0x00, 0x00, 0x3F,
+	0xA4, 0x20, 0x00, 0x3F, 0xFF, 0x00, 0x85, 0x00,
+};
+
+/*settingsScreen: 1024 -> 282 bytes*/
+static const uint8_t settingsScreenBackground[] = {
+	0x06, 0x7F, 0x02, 0x04, 0x02, 0x7F, 0x00, 0x20, 0x81, 0x54, 0x02, 0x78, 0x00, 0x38, 0x81, 0x44,
+	0x14, 0x20, 0x00, 0x7F, 0x08, 0x04, 0x04, 0x78, 0x00, 0x00, 0x44, 0x7D, 0x40, 0x00, 0x00, 0x7C,
+	0x08, 0x04, 0x04, 0x78, 0x00, 0x38, 0x81, 0x54, 0x00, 0x18, 0x85, 0x00, 0x09, 0x7C, 0x04, 0x18,
+	0x04, 0x78, 0x00, 0x00, 0x44, 0x7D, 0x40, 0x81, 0x00, 0x05, 0x41, 0x7F, 0x40, 0x00, 0x00, 0x38,
+	0x81, 0x54, 0x02, 0x18, 0x00, 0x20, 0x81, 0x54, 0x08, 0x78, 0x00, 0x08, 0x14, 0x54, 0x54, 0x3C,
+	0x00, 0x38, 0x81, 0x54, 0x04, 0x18, 0x00, 0x00, 0x36, 0x36, 0xFF, 0x00, 0xA0, 0x00, 0x00, 0x60,
+	0x81, 0x90, 0x02, 0x10, 0x00, 0x80, 0x81, 0x40, 0x08, 0x80, 0x00, 0xC0, 0x80, 0x40, 0x40, 0x80,
+	0x00, 0xC0, 0x81, 0x00, 0x04, 0xC0, 0x00, 0x00, 0x40, 0xD0, 0x81, 0x00, 0x00, 0x80, 0x81, 0x40,
+	0x80, 0x00, 0x00, 0x80, 0x81, 0x40, 0x00, 0x80, 0x86, 0x00, 0x01, 0x40, 0xD0, 0x81, 0x00, 0x08,
+	0xC0, 0x80, 0x40, 0x40, 0x80, 0x00, 0x00, 0x60, 0x60, 0xBF, 0x00, 0x82, 0x04, 0x02, 0x03, 0x00,
+	0x03, 0x81, 0x05, 0x02, 0x01, 0x00, 0x07, 0x83, 0x00, 0x0C, 0x01, 0x02, 0x04, 0x02, 0x01, 0x00,
+	0x00, 0x04, 0x07, 0x04, 0x00, 0x00, 0x03, 0x81, 0x04, 0x02, 0x02, 0x00, 0x03, 0x81, 0x05, 0x00,
+	0x01, 0x86, 0x00, 0x05, 0x04, 0x07, 0x04, 0x00, 0x00, 0x07, 0x81, 0x00, 0x04, 0x07, 0x00, 0x00,
+	0x03, 0x03, 0xFF, 0x00, 0xBE, 0x00, 0x00, 0x7C, 0x81, 0x82, 0x06, 0x7C, 0x00, 0xF8, 0x10, 0x08,
+	0x08, 0xF0, 0x85, 0x00, 0x12, 0x08, 0x7E, 0x88, 0x80, 0x40, 0x00, 0x00, 0x88, 0xFA, 0x80, 0x00,
+	0x00, 0xF8, 0x08, 0x30, 0x08, 0xF0, 0x00, 0x70, 0x81, 0xA8, 0x00, 0x30, 0x85, 0x00, 0x00, 0x40,
+	0x81, 0xA8, 0x08, 0xF0, 0x00, 0x10, 0x28, 0xA8, 0xA8, 0x78, 0x00, 0x70, 0x81, 0xA8, 0x04, 0x30,
+	0x00, 0x00, 0x6C, 0x6C, 0xFF, 0x00, 0xFF, 0x00, 0xB7, 0x00,
+};
+
+/*settingsScreenOverdue: 1024 -> 341 bytes*/
+static const uint8_t settingsScreenOverdueBackground[] = {
+	0x06, 0x7F, 0x02, 0x04, 0x02, 0x7F, 0x00, 0x20, 0x81, 0x54, 0x02, 0x78, 0x00, 0x38, 0x81, 0x44,
+	0x14, 0x20, 0x00, 0x7F, 0x08, 0x04, 0x04, 0x78, 0x00, 0x00, 0x44, 0x7D, 0x40, 0x00, 0x00, 0x7C,
+	0x08, 0x04, 0x04, 0x78, 0x00, 0x38, 0x81, 0x54, 0x00, 0x18, 0x85, 0x00, 0x09, 0x7C, 0x04, 0x18,
+	0x04, 0x78, 0x00, 0x00, 0x44, 0x7D, 0x40, 0x81, 0x00, 0x05, 0x41, 0x7F, 0x40, 0x00, 0x00, 0x38,
+	0x81, 0x54, 0x02, 0x18, 0x00, 0x20, 0x81, 0x54, 0x08, 0x78, 0x00, 0x08, 0x14, 0x54, 0x54, 0x3C,
+	0x00, 0x38, 0x81, 0x54, 0x04, 0x18, 0x00, 0x00, 0x36, 0x36, 0xFF, 0x00, 0xA0, 0x00, 0x00, 0x60,
+	0x81, 0x90, 0x02, 0x10, 0x00, 0x80, 0x81, 0x40, 0x08, 0x80, 0x00, 0xC0, 0x80, 0x40, 0x40, 0x80,
+	0x00, 0xC0, 0x81, 0x00, 0x04, 0xC0, 0x00, 0x00, 0x40, 0xD0, 0x81, 0x00, 0x00, 0x80, 0x81, 0x40,
+	0x80, 0x00, 0x00, 0x80, 0x81, 0x40, 0x00, 0x80, 0x86, 0x00, 0x01, 0x40, 0xD0, 0x81, 0x00, 0x08,
+	0xC0, 0x80, 0x40, 0x40, 0x80, 0x00, 0x00, 0x60, 0x60, 0xBF, 0x00, 0x00, 0x84, 0x81, 0x44, 0x02,
+	0x83, 0x00, 0x03, 0x81, 0x05, 0x02, 0x01, 0x00, 0x07, 0x83, 0x00, 0x0C, 0x01, 0x02, 0x04, 0x02,
+	0x01, 0x00, 0x00, 0x04, 0x07, 0x04, 0xC0, 0x00, 0x03, 0x81, 0x04, 0x02, 0x02, 0x00, 0x03, 0x81,
+	0x05, 0x00, 0x01, 0x85, 0x00, 0x06, 0xC0, 0x04, 0x07, 0x04, 0x00, 0x00, 0x07, 0x81, 0x00, 0x04,
+	0x07, 0x00, 0x00, 0x03, 0x03, 0xBF, 0x00, 0x00, 0x0F, 0x81, 0x10, 0x08, 0x0F, 0x00, 0x07, 0x08,
+	0x10, 0x08, 0x07, 0x00, 0x0E, 0x81, 0x15, 0x14, 0x06, 0x00, 0x1F, 0x02, 0x01, 0x01, 0x02, 0x00,
+	0x0E, 0x11, 0x11, 0x12, 0x1F, 0x00, 0x0F, 0x10, 0x10, 0x08, 0x1F, 0x00, 0x0E, 0x81, 0x15, 0x00,
+	0x06, 0x85, 0x00, 0x06, 0x1F, 0x12, 0x11, 0x11, 0x0E, 0x00, 0x03, 0x81, 0x14, 0x00, 0x0F, 0xC3,
+	0x00, 0x00, 0x7C, 0x81, 0x82, 0x06, 0x7C, 0x00, 0xF8, 0x10, 0x08, 0x08, 0xF0, 0x85, 0x00, 0x12,
+	0x08, 0x7E, 0x88, 0x80, 0x40, 0x00, 0x00, 0x88, 0xFA, 0x80, 0x00, 0x00, 0xF8, 0x08, 0x30, 0x08,
+	0xF0, 0x00, 0x70, 0x81, 0xA8, 0x00, 0x30, 0x85, 0x00, 0x00, 0x40, 0x81, 0xA8, 0x08, 0xF0, 0x00,
+	0x10, 0x28, 0xA8, 0xA8, 0x78, 0x00, 0x70, 0x81, 0xA8, 0x04, 0x30, 0x00, 0x00, 0x6C, 0x6C, 0xFF,
+	0x00, 0xFF, 0x00, 0xB7, 0x00,
+};
+
+/*jobHistoryScreen: 1024 -> 303 bytes*/
+static const uint8_t jobHistoryScreenBackground[] = {
+	0x06, 0x20, 0x40, 0x41, 0x3F, 0x01, 0x00, 0x38, 0x81, 0x44, 0x06, 0x38, 0x00, 0x7F, 0x48, 0x44,
+	0x44, 0x38, 0xED, 0x00, 0x03, 0xC0, 0x40, 0x40, 0x80, 0x82, 0x00, 0x00, 0x40, 0x88, 0x00, 0x00,
+	0xC0, 0x9B, 0x00, 0x80, 0x80, 0xCB, 0x00, 0x0C, 0x1F, 0x10, 0x10, 0x08, 0x07, 0x00, 0x00, 0x11,
+	0x1F, 0x10, 0x00, 0x00, 0x12, 0x81, 0x15, 0x08, 0x08, 0x00, 0x01, 0x0F, 0x11, 0x10, 0x08, 0x00,
+	0x08, 0x81, 0x15, 0x08, 0x1E, 0x00, 0x1F, 0x02, 0x01, 0x01, 0x1E, 0x00, 0x0E, 0x81, 0x11, 0x02,
+	0x08, 0x00, 0x0E, 0x81, 0x15, 0x04, 0x06, 0x00, 0x00, 0x0D, 0x0D, 0xCB, 0x00, 0x80, 0x04, 0x06,
+	0xFC, 0x04, 0x04, 0x00, 0x00, 0x10, 0xF4, 0x81, 0x00, 0x06, 0xF0, 0x10, 0x60, 0x10, 0xE0, 0x00,
+	0xE0, 0x81, 0x50, 0x04, 0x60, 0x00, 0x00, 0xD8, 0xD8, 0xE3, 0x00, 0x06, 0xC0, 0x80, 0x01, 0x80,
+	0xC0, 0x00, 0x00, 0x81, 0x01, 0x80, 0x00, 0x00, 0x01, 0x81, 0x00, 0x02, 0x01, 0x00, 0x00, 0x81,
+	0x01, 0x9C, 0x00, 0x04, 0xC0, 0x00, 0x00, 0x80, 0x80, 0xC5, 0x00, 0x06, 0x1F, 0x00, 0x01, 0x00,
+	0x1F, 0x00, 0x08, 0x81, 0x15, 0x06, 0x1E, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x85, 0x00, 0x00,
+	0x12, 0x81, 0x15, 0x02, 0x08, 0x00, 0x1F, 0x81, 0x05, 0x02, 0x02, 0x00, 0x0E, 0x81, 0x15, 0x02,
+	0x06, 0x00, 0x0E, 0x81, 0x15, 0x0A, 0x06, 0x00, 0x0E, 0x11, 0x11, 0x12, 0x1F, 0x00, 0x00, 0x0D,
+	0x0D, 0xC5, 0x00, 0x00, 0xF8, 0x81, 0x44, 0x08, 0xF8, 0x00, 0x70, 0x80, 0x00, 0x80, 0x70, 0x00,
+	0x20, 0x81, 0x50, 0x00, 0xF0, 0x85, 0x00, 0x00, 0x20, 0x81, 0x50, 0x02, 0x80, 0x00, 0xF0, 0x81,
+	0x50, 0x02, 0x20, 0x00, 0xE0, 0x81, 0x50, 0x02, 0x60, 0x00, 0xE0, 0x81, 0x50, 0x0A, 0x60, 0x00,
+	0xE0, 0x10, 0x10, 0x20, 0xFC, 0x00, 0x00, 0xD8, 0xD8, 0xC5, 0x00, 0x00, 0x01, 0x81, 0x00, 0x00,
+	0x01, 0x81, 0x00, 0x00, 0x01, 0x83, 0x00, 0x80, 0x01, 0x86, 0x00, 0x82, 0x01, 0x80, 0x00, 0x00,
+	0x01, 0x84, 0x00, 0x81, 0x01, 0x81, 0x00, 0x81, 0x01, 0x81, 0x00, 0x82, 0x01, 0xC9, 0x00,
+};
+
+#endif
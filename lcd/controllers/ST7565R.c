@@ -52,11 +52,18 @@ void glcd_power_down(void)
 void glcd_power_up(void)
 {
 	glcd_command(0xa4); // Display all points OFF
+#if !defined(GLCD_INIT_ZOLEN_12864_FFSSWE_NAA)
+	/* The ST7567 has no static indicator */
 	glcd_command(0xad);	// Static indicator ON
 	glcd_command(0x00);	// Static indicator register, not Blinking
+#endif
 	glcd_command(0xaf);
 
-	return;
+	/* The frame buffer may have moved on while the display slept */
+	glcd_update_bbox(0, 0, GLCD_LCD_WIDTH - 1, GLCD_LCD_HEIGHT - 1);
+#if !defined(GLCD_USE_STRIP_BUFFER)
+	glcd_write();
+#endif
 }
 
 void glcd_set_y_address(uint8_t y)
@@ -130,6 +137,8 @@ void glcd_write()
 	for (bank = 0; bank < GLCD_NUMBER_OF_BANKS; bank++) {
 		/* Each bank is a single row 8 bits tall */
 		uint8_t column;		
+		glcd_OverlaySpan_t spans[GLCD_MAX_OVERLAYS];
+		uint8_t span_count;
 		
 		if (glcd_bbox_selected->y_min >= (bank+1)*8) {
 			continue; /* Skip the entire bank */
@@ -138,13 +147,22 @@ void glcd_write()
 		if (glcd_bbox_selected->y_max < bank*8) {
 			break;    /* No more banks need updating */
 		}
+		if (!GLCD_PAGE_VISIBLE(bank)) {
+			continue; /* Strip buffer, this bank is sent when it is rendered */
+		}
 		
 		glcd_set_y_address(bank);
 		glcd_set_x_address(glcd_bbox_selected->x_min);
 
+		/* Overlays are combined with the bytes as they go out, the buffer is left alone */
+		span_count = glcd_overlay_spans(bank, spans);
 		for (column = glcd_bbox_selected->x_min; column <= glcd_bbox_selected->x_max; column++)
 		{
-			glcd_data( glcd_buffer_selected[GLCD_NUMBER_OF_COLS * bank + column] );
+			if (span_count) {
+				glcd_data( glcd_overlay_apply(GLCD_PAGE(bank)[column], column, spans, span_count) );
+			} else {
+				glcd_data( GLCD_PAGE(bank)[column] );
+			}
 		}
 	}
 
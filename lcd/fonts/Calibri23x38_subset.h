@@ -0,0 +1,74 @@
+/*
+ * Calibri23x38 subset for the screens, PACKED format(see font_table_type_t). 11 of 12 glyphs,
+ * 920 bytes with the charmap(original: 1392 bytes). Characters ".0123456789"
+ * Generated by tools/fonts/mkfonts.sh from lcd/fonts/Calibri23x38.h and the strings drawn with fontLarge. Do not edit.
+ */
+#pragma once
+
+#define Calibri23x38_FIRST_CHAR 46
+#define Calibri23x38_LAST_CHAR 57
+
+/*Glyph number of every character from Calibri23x38_FIRST_CHAR to Calibri23x38_LAST_CHAR, GLCD_NO_GLYPH for the ones left out. See glcd_FontConfig_t.charmap*/
+static const uint8_t Calibri23x38_charmap[] = {
+	0x00, 0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A,
+};
+
+static const char Calibri23x38_subset[] = {
+	0x16, 0x00, 0x22, 0x00, 0x7F, 0x00, 0xD0, 0x00, 0x25, 0x01, 0x7A, 0x01, 0xD7, 0x01, 0x2C, 0x02,
+	0x85, 0x02, 0xDA, 0x02, 0x33, 0x03, 0x09, 0x02, 0x07, 0x1A, 0x07, 0x3E, 0x7F, 0x7F, 0x7F, 0x7F,
+	0x7F, 0x3E, 0x16, 0x00, 0x16, 0x02, 0x20, 0x80, 0xFF, 0xFF, 0x01, 0xC0, 0xFF, 0xFF, 0x03, 0xF0,
+	0xFF, 0xFF, 0x0F, 0xF8, 0xFF, 0xFF, 0x1F, 0xFC, 0xFF, 0xFF, 0x3F, 0xFE, 0xFF, 0xFF, 0x7F, 0xFE,
+	0x01, 0x80, 0x7F, 0x7E, 0x00, 0x00, 0xFE, 0x3F, 0x00, 0x00, 0xFC, 0x1F, 0x00, 0x00, 0xF8, 0x1F,
+	0x00, 0x00, 0xF8, 0x1F, 0x00, 0x00, 0xF8, 0x1F, 0x00, 0x00, 0xF8, 0x3F, 0x00, 0x00, 0xFC, 0x7F,
+	0x00, 0x00, 0x7E, 0xFE, 0x01, 0x80, 0x7F, 0xFE, 0xFF, 0xFF, 0x7F, 0xFC, 0xFF, 0xFF, 0x3F, 0xFC,
+	0xFF, 0xFF, 0x1F, 0xF0, 0xFF, 0xFF, 0x0F, 0xC0, 0xFF, 0xFF, 0x03, 0x80, 0xFF, 0xFF, 0x01, 0x15,
+	0x02, 0x13, 0x03, 0x1E, 0xE0, 0x01, 0x00, 0x3E, 0xF0, 0x01, 0x00, 0x3E, 0xF0, 0x01, 0x00, 0x3E,
+	0xF8, 0x00, 0x00, 0x3E, 0x7C, 0x00, 0x00, 0x3E, 0x7C, 0x00, 0x00, 0x3E, 0x3E, 0x00, 0x00, 0x3E,
+	0xFF, 0xFF, 0xFF, 0x3F, 0xFF, 0xFF, 0xFF, 0x3F, 0xFF, 0xFF, 0xFF, 0x3F, 0xFF, 0xFF, 0xFF, 0x3F,
+	0xFF, 0xFF, 0xFF, 0x3F, 0xFF, 0xFF, 0xFF, 0x3F, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x00, 0x00, 0x3E,
+	0x00, 0x00, 0x00, 0x3E, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x00, 0x00, 0x3E,
+	0x15, 0x01, 0x14, 0x02, 0x1F, 0x00, 0x00, 0x00, 0x7C, 0xF8, 0x00, 0x00, 0x7F, 0xFC, 0x00, 0x80,
+	0x7F, 0x7E, 0x00, 0xC0, 0x7F, 0x7E, 0x00, 0xE0, 0x7F, 0x3E, 0x00, 0xF0, 0x7F, 0x3F, 0x00, 0xF8,
+	0x7F, 0x3F, 0x00, 0xFC, 0x7D, 0x3F, 0x00, 0xFE, 0x7C, 0x3F, 0x00, 0x7F, 0x7C, 0x7F, 0xC0, 0x3F,
+	0x7C, 0xFF, 0xF0, 0x1F, 0x7C, 0xFF, 0xFF, 0x0F, 0x7C, 0xFF, 0xFF, 0x07, 0x7C, 0xFE, 0xFF, 0x03,
+	0x7C, 0xFE, 0xFF, 0x01, 0x7C, 0xFC, 0xFF, 0x00, 0x7C, 0xF8, 0x3F, 0x00, 0x7C, 0xE0, 0x0F, 0x00,
+	0x7C, 0x00, 0x00, 0x00, 0x7C, 0x15, 0x01, 0x14, 0x02, 0x20, 0x00, 0x00, 0x00, 0x3E, 0x7C, 0x00,
+	0x00, 0x3E, 0x7C, 0x00, 0x00, 0x7C, 0x3E, 0xE0, 0x03, 0x7C, 0x3E, 0xE0, 0x03, 0xF8, 0x1E, 0xE0,
+	0x03, 0xF8, 0x1F, 0xE0, 0x03, 0xF8, 0x1F, 0xE0, 0x03, 0xF8, 0x1F, 0xE0, 0x03, 0xF8, 0x1F, 0xF0,
+	0x03, 0xF8, 0x3F, 0xF0, 0x07, 0xFC, 0x7F, 0xF8, 0x07, 0xFC, 0xFF, 0xFF, 0x1F, 0xFE, 0xFF, 0xFF,
+	0xFF, 0x7F, 0xFE, 0xFF, 0xFF, 0x7F, 0xFE, 0xBF, 0xFF, 0x3F, 0xFC, 0x3F, 0xFF, 0x3F, 0xF8, 0x1F,
+	0xFE, 0x1F, 0xE0, 0x07, 0xFC, 0x0F, 0x00, 0x00, 0xF8, 0x03, 0x16, 0x00, 0x16, 0x03, 0x1E, 0x00,
+	0x00, 0xFC, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xC0, 0xFF, 0x00, 0x00, 0xF0, 0xFF, 0x00, 0x00,
+	0xF8, 0xFF, 0x00, 0x00, 0xFE, 0xFB, 0x00, 0x80, 0xFF, 0xF8, 0x00, 0xC0, 0x7F, 0xF8, 0x00, 0xF0,
+	0x1F, 0xF8, 0x00, 0xFC, 0x07, 0xF8, 0x00, 0xFE, 0x01, 0xF8, 0x00, 0xFF, 0x00, 0xF8, 0x00, 0x3F,
+	0x00, 0xF8, 0x00, 0xFF, 0xFF, 0xFF, 0x3F, 0xFF, 0xFF, 0xFF, 0x3F, 0xFF, 0xFF, 0xFF, 0x3F, 0xFF,
+	0xFF, 0xFF, 0x3F, 0xFF, 0xFF, 0xFF, 0x3F, 0xFF, 0xFF, 0xFF, 0x3F, 0x00, 0x00, 0xF8, 0x00, 0x00,
+	0x00, 0xF8, 0x00, 0x00, 0x00, 0xF8, 0x00, 0x15, 0x01, 0x14, 0x03, 0x1F, 0x00, 0x00, 0x00, 0x1F,
+	0xFF, 0xFF, 0x00, 0x1F, 0xFF, 0xFF, 0x00, 0x3E, 0xFF, 0xFF, 0x00, 0x3E, 0xFF, 0xFF, 0x00, 0x7C,
+	0xFF, 0xFF, 0x00, 0x7C, 0x1F, 0xF8, 0x00, 0x7C, 0x1F, 0xF8, 0x00, 0x7C, 0x1F, 0xF8, 0x00, 0x7C,
+	0x1F, 0xF8, 0x00, 0x7C, 0x1F, 0xF8, 0x01, 0x7E, 0x1F, 0xF8, 0x01, 0x7E, 0x1F, 0xF8, 0x83, 0x3F,
+	0x1F, 0xF8, 0xFF, 0x3F, 0x1F, 0xF0, 0xFF, 0x3F, 0x1F, 0xF0, 0xFF, 0x1F, 0x1F, 0xE0, 0xFF, 0x0F,
+	0x1F, 0xC0, 0xFF, 0x07, 0x00, 0x80, 0xFF, 0x03, 0x00, 0x00, 0xFE, 0x00, 0x16, 0x01, 0x15, 0x02,
+	0x20, 0x00, 0xF8, 0xFF, 0x00, 0x00, 0xFF, 0xFF, 0x07, 0xE0, 0xFF, 0xFF, 0x1F, 0xF0, 0xFF, 0xFF,
+	0x3F, 0xF8, 0xFF, 0xFF, 0x7F, 0xFC, 0xFF, 0xFF, 0x7F, 0xFC, 0xE3, 0x03, 0x7F, 0xFE, 0xE0, 0x03,
+	0xFC, 0x3E, 0xE0, 0x01, 0xF8, 0x3F, 0xF0, 0x01, 0xF8, 0x1F, 0xF0, 0x01, 0xF8, 0x1F, 0xF0, 0x01,
+	0xF8, 0x1F, 0xF0, 0x01, 0xF8, 0x1F, 0xF0, 0x03, 0xFC, 0x1F, 0xF0, 0x07, 0x7F, 0x1F, 0xF0, 0xFF,
+	0x7F, 0x3F, 0xE0, 0xFF, 0x3F, 0x3E, 0xE0, 0xFF, 0x3F, 0x3E, 0xC0, 0xFF, 0x1F, 0x00, 0x80, 0xFF,
+	0x07, 0x00, 0x00, 0xFE, 0x01, 0x15, 0x01, 0x14, 0x03, 0x1E, 0x1F, 0x00, 0x00, 0x00, 0x1F, 0x00,
+	0x00, 0x00, 0x1F, 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x38, 0x1F, 0x00, 0x00, 0x3E, 0x1F, 0x00,
+	0x80, 0x3F, 0x1F, 0x00, 0xF0, 0x3F, 0x1F, 0x00, 0xFC, 0x3F, 0x1F, 0x00, 0xFF, 0x3F, 0x1F, 0xE0,
+	0xFF, 0x3F, 0x1F, 0xF8, 0xFF, 0x0F, 0x1F, 0xFE, 0xFF, 0x01, 0xDF, 0xFF, 0x7F, 0x00, 0xFF, 0xFF,
+	0x0F, 0x00, 0xFF, 0xFF, 0x03, 0x00, 0xFF, 0x7F, 0x00, 0x00, 0xFF, 0x1F, 0x00, 0x00, 0xFF, 0x07,
+	0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x15, 0x00, 0x15, 0x02, 0x20, 0x00,
+	0x00, 0xE0, 0x07, 0xE0, 0x07, 0xF8, 0x1F, 0xF8, 0x1F, 0xFC, 0x3F, 0xFC, 0x3F, 0xFE, 0x7F, 0xFC,
+	0x7F, 0xFE, 0x7F, 0xFE, 0xFF, 0xFF, 0x7F, 0xFE, 0xFF, 0x1F, 0xFE, 0x3F, 0xFC, 0x0F, 0xFC, 0x1F,
+	0xF8, 0x07, 0xF8, 0x1F, 0xF0, 0x07, 0xF8, 0x1F, 0xE0, 0x03, 0xF8, 0x1F, 0xE0, 0x07, 0xF8, 0x1F,
+	0xF0, 0x07, 0xF8, 0x3F, 0xFC, 0x0F, 0xFC, 0xFF, 0xFF, 0x1F, 0xFE, 0xFE, 0xFF, 0xFF, 0x7F, 0xFE,
+	0x3F, 0xFF, 0x7F, 0xFC, 0x1F, 0xFE, 0x3F, 0xF8, 0x0F, 0xFC, 0x1F, 0xE0, 0x03, 0xF8, 0x0F, 0x00,
+	0x00, 0xF0, 0x03, 0x16, 0x01, 0x15, 0x02, 0x20, 0x80, 0x7F, 0x00, 0x00, 0xE0, 0xFF, 0x01, 0x7C,
+	0xF8, 0xFF, 0x03, 0x7C, 0xFC, 0xFF, 0x07, 0x7C, 0xFC, 0xFF, 0x07, 0xF8, 0xFE, 0xFF, 0x0F, 0xF8,
+	0x7E, 0xE0, 0x0F, 0xF8, 0x3F, 0xC0, 0x0F, 0xF8, 0x1F, 0x80, 0x0F, 0xF8, 0x1F, 0x80, 0x0F, 0xF8,
+	0x1F, 0x80, 0x0F, 0xF8, 0x1F, 0x80, 0x0F, 0xFC, 0x1F, 0x80, 0x07, 0x7E, 0x3F, 0xC0, 0x07, 0x7F,
+	0xFE, 0xC0, 0xC7, 0x3F, 0xFE, 0xFF, 0xFF, 0x3F, 0xFE, 0xFF, 0xFF, 0x1F, 0xFC, 0xFF, 0xFF, 0x0F,
+	0xF8, 0xFF, 0xFF, 0x03, 0xE0, 0xFF, 0xFF, 0x00, 0x00, 0xFF, 0x1F, 0x00,
+};
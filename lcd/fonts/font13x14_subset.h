@@ -0,0 +1,44 @@
+/*
+ * Trebuchet_MS13x14 subset for the screens, PACKED format(see font_table_type_t). 20 of 96 glyphs,
+ * 438 bytes with the charmap(original: 2592 bytes). Characters " %*-./0123456789Cimn"
+ * Generated by tools/fonts/mkfonts.sh from lcd/fonts/font13x14.h and the strings drawn with fontMedium. Do not edit.
+ */
+#pragma once
+
+#define Trebuchet_MS13x14_FIRST_CHAR 32
+#define Trebuchet_MS13x14_LAST_CHAR 110
+
+/*Glyph number of every character from Trebuchet_MS13x14_FIRST_CHAR to Trebuchet_MS13x14_LAST_CHAR, GLCD_NO_GLYPH for the ones left out. See glcd_FontConfig_t.charmap*/
+static const uint8_t Trebuchet_MS13x14_charmap[] = {
+	0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0x02, 0xFF, 0xFF, 0x03, 0x04, 0x05,
+	0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0x10, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x11, 0xFF, 0xFF, 0xFF, 0x12, 0x13,
+};
+
+static const char Trebuchet_MS13x14_subset[] = {
+	0x28, 0x00, 0x2D, 0x00, 0x44, 0x00, 0x4F, 0x00, 0x58, 0x00, 0x5F, 0x00, 0x70, 0x00, 0x85, 0x00,
+	0x92, 0x00, 0xA5, 0x00, 0xB6, 0x00, 0xC9, 0x00, 0xDC, 0x00, 0xEF, 0x00, 0x04, 0x01, 0x17, 0x01,
+	0x2A, 0x01, 0x3F, 0x01, 0x4A, 0x01, 0x5B, 0x01, 0x07, 0x00, 0x00, 0x00, 0x00, 0x09, 0x00, 0x09,
+	0x01, 0x0B, 0x0E, 0x00, 0x11, 0x04, 0x11, 0x03, 0xCE, 0x00, 0x20, 0x00, 0x98, 0x03, 0x46, 0x04,
+	0x41, 0x04, 0x80, 0x03, 0x06, 0x00, 0x06, 0x00, 0x06, 0x04, 0x3C, 0x1F, 0x1F, 0x3C, 0x04, 0x05,
+	0x01, 0x04, 0x06, 0x02, 0x03, 0x03, 0x03, 0x03, 0x03, 0x01, 0x02, 0x0A, 0x02, 0x03, 0x03, 0x06,
+	0x00, 0x06, 0x01, 0x0B, 0x00, 0x04, 0x80, 0x07, 0xF0, 0x03, 0x7E, 0x00, 0x1F, 0x00, 0x03, 0x00,
+	0x08, 0x00, 0x08, 0x01, 0x0B, 0xFC, 0x01, 0xFE, 0x03, 0x07, 0x07, 0x03, 0x06, 0x03, 0x06, 0x07,
+	0x07, 0xFE, 0x03, 0xFC, 0x01, 0x06, 0x02, 0x04, 0x01, 0x0B, 0x1C, 0x00, 0x0E, 0x00, 0xFF, 0x07,
+	0xFF, 0x07, 0x08, 0x01, 0x07, 0x01, 0x0B, 0x02, 0x06, 0x07, 0x07, 0xC3, 0x07, 0xE3, 0x06, 0x3F,
+	0x06, 0x1E, 0x06, 0x00, 0x06, 0x07, 0x01, 0x06, 0x01, 0x0B, 0x02, 0x02, 0x03, 0x06, 0x33, 0x06,
+	0x33, 0x06, 0xFF, 0x07, 0xEE, 0x03, 0x08, 0x01, 0x07, 0x01, 0x0B, 0xC0, 0x00, 0xF0, 0x00, 0xD8,
+	0x00, 0xCE, 0x00, 0xFF, 0x07, 0xFF, 0x07, 0xC0, 0x00, 0x08, 0x01, 0x07, 0x01, 0x0B, 0x7F, 0x02,
+	0x3F, 0x07, 0x33, 0x06, 0x33, 0x06, 0x33, 0x06, 0xF3, 0x03, 0xE0, 0x01, 0x08, 0x01, 0x07, 0x01,
+	0x0B, 0xF0, 0x01, 0xFC, 0x03, 0x3E, 0x06, 0x33, 0x06, 0x31, 0x06, 0xF0, 0x03, 0xE0, 0x01, 0x08,
+	0x00, 0x08, 0x01, 0x0B, 0x03, 0x00, 0x03, 0x04, 0x83, 0x07, 0xE3, 0x03, 0x7B, 0x00, 0x1F, 0x00,
+	0x07, 0x00, 0x03, 0x00, 0x08, 0x01, 0x07, 0x01, 0x0B, 0xCE, 0x03, 0xFF, 0x07, 0x33, 0x06, 0x33,
+	0x06, 0x33, 0x06, 0xFF, 0x07, 0xCE, 0x03, 0x08, 0x01, 0x07, 0x01, 0x0B, 0x1C, 0x00, 0x3E, 0x00,
+	0x63, 0x04, 0x63, 0x06, 0xE3, 0x03, 0xFE, 0x01, 0x7C, 0x00, 0x09, 0x01, 0x08, 0x01, 0x0B, 0xF8,
+	0x00, 0xFE, 0x03, 0x07, 0x07, 0x03, 0x06, 0x03, 0x06, 0x03, 0x06, 0x07, 0x07, 0x02, 0x02, 0x04,
+	0x01, 0x03, 0x01, 0x0B, 0x18, 0x00, 0xFB, 0x07, 0xFB, 0x07, 0x0D, 0x01, 0x0C, 0x04, 0x08, 0xFF,
+	0xFF, 0x03, 0x03, 0x03, 0xFF, 0xFE, 0x03, 0x03, 0x03, 0xFF, 0xFE, 0x08, 0x01, 0x07, 0x04, 0x08,
+	0xFF, 0xFF, 0x03, 0x03, 0x03, 0xFF, 0xFE,
+};
@@ -0,0 +1,37 @@
+/*
+ * Font5x7 subset for the screens, STANG format(see font_table_type_t). 48 of 96 glyphs,
+ * 330 bytes with the charmap(original: 480 bytes). Characters " !%-./0123456789:ABCDHJMOSTabcdeghilmnoprstuvwxy"
+ * Generated by tools/fonts/mkfonts.sh from lcd/fonts/font5x7.h and the strings drawn with fontSmall. Do not edit.
+ */
+#pragma once
+
+#define Font5x7_FIRST_CHAR 32
+#define Font5x7_LAST_CHAR 121
+
+/*Glyph number of every character from Font5x7_FIRST_CHAR to Font5x7_LAST_CHAR, GLCD_NO_GLYPH for the ones left out. See glcd_FontConfig_t.charmap*/
+static const uint8_t Font5x7_charmap[] = {
+	0x00, 0x01, 0xFF, 0xFF, 0xFF, 0x02, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x03, 0x04, 0x05,
+	0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x11, 0x12, 0x13, 0x14, 0xFF, 0xFF, 0xFF, 0x15, 0xFF, 0x16, 0xFF, 0xFF, 0x17, 0xFF, 0x18,
+	0xFF, 0xFF, 0xFF, 0x19, 0x1A, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0xFF, 0x20, 0x21, 0x22, 0xFF, 0xFF, 0x23, 0x24, 0x25, 0x26,
+	0x27, 0xFF, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F,
+};
+
+static const char Font5x7_subset[] = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5F, 0x00, 0x00, 0x23, 0x13, 0x08, 0x64, 0x62, 0x08,
+	0x08, 0x08, 0x08, 0x08, 0x00, 0x60, 0x60, 0x00, 0x00, 0x20, 0x10, 0x08, 0x04, 0x02, 0x3E, 0x51,
+	0x49, 0x45, 0x3E, 0x00, 0x42, 0x7F, 0x40, 0x00, 0x42, 0x61, 0x51, 0x49, 0x46, 0x21, 0x41, 0x45,
+	0x4B, 0x31, 0x18, 0x14, 0x12, 0x7F, 0x10, 0x27, 0x45, 0x45, 0x45, 0x39, 0x3C, 0x4A, 0x49, 0x49,
+	0x30, 0x01, 0x71, 0x09, 0x05, 0x03, 0x36, 0x49, 0x49, 0x49, 0x36, 0x06, 0x49, 0x49, 0x29, 0x1E,
+	0x00, 0x36, 0x36, 0x00, 0x00, 0x7E, 0x11, 0x11, 0x11, 0x7E, 0x7F, 0x49, 0x49, 0x49, 0x36, 0x3E,
+	0x41, 0x41, 0x41, 0x22, 0x7F, 0x41, 0x41, 0x22, 0x1C, 0x7F, 0x08, 0x08, 0x08, 0x7F, 0x20, 0x40,
+	0x41, 0x3F, 0x01, 0x7F, 0x02, 0x04, 0x02, 0x7F, 0x3E, 0x41, 0x41, 0x41, 0x3E, 0x46, 0x49, 0x49,
+	0x49, 0x31, 0x01, 0x01, 0x7F, 0x01, 0x01, 0x20, 0x54, 0x54, 0x54, 0x78, 0x7F, 0x48, 0x44, 0x44,
+	0x38, 0x38, 0x44, 0x44, 0x44, 0x20, 0x38, 0x44, 0x44, 0x48, 0x7F, 0x38, 0x54, 0x54, 0x54, 0x18,
+	0x08, 0x14, 0x54, 0x54, 0x3C, 0x7F, 0x08, 0x04, 0x04, 0x78, 0x00, 0x44, 0x7D, 0x40, 0x00, 0x00,
+	0x41, 0x7F, 0x40, 0x00, 0x7C, 0x04, 0x18, 0x04, 0x78, 0x7C, 0x08, 0x04, 0x04, 0x78, 0x38, 0x44,
+	0x44, 0x44, 0x38, 0x7C, 0x14, 0x14, 0x14, 0x08, 0x7C, 0x08, 0x04, 0x04, 0x08, 0x48, 0x54, 0x54,
+	0x54, 0x20, 0x04, 0x3F, 0x44, 0x40, 0x20, 0x3C, 0x40, 0x40, 0x20, 0x7C, 0x1C, 0x20, 0x40, 0x20,
+	0x1C, 0x3C, 0x40, 0x30, 0x40, 0x3C, 0x44, 0x28, 0x10, 0x28, 0x44, 0x0C, 0x50, 0x50, 0x50, 0x3C,
+};
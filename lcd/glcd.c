@@ -44,9 +44,17 @@
 /**
  *  Screen buffer
  *
- *  Requires at least one bit for every pixel (e.g 504 bytes for 48x84 LCD)
+ *  Requires at least one bit for every pixel (e.g 504 bytes for 48x84 LCD),
+ *  or one page of GLCD_LCD_WIDTH bytes with GLCD_USE_STRIP_BUFFER
  */
-uint8_t glcd_buffer[GLCD_LCD_WIDTH * GLCD_LCD_HEIGHT / 8];
+uint8_t glcd_buffer[GLCD_BUFFER_SIZE];
+
+#if defined(GLCD_USE_STRIP_BUFFER)
+/**
+ * Page(8 pixel rows) the screen buffer holds
+ */
+uint8_t glcd_strip_page;
+#endif
 
 /**
  * Keeps track of bounding box of area on LCD which need to be
@@ -120,16 +128,47 @@ void glcd_bbox_refresh() {
 }
 
 void glcd_clear(void) {
-	memset(glcd_buffer_selected, 0x00, GLCD_LCD_WIDTH * GLCD_LCD_HEIGHT / 8);
+	memset(glcd_buffer_selected, 0x00, GLCD_BUFFER_SIZE);
+#if defined(GLCD_USE_STRIP_BUFFER)
+	/* The other pages are not in RAM, clear the LCD directly */
+	glcd_clear_now();
+	glcd_reset_bbox();
+#else
 	glcd_update_bbox(0,0,GLCD_LCD_WIDTH - 1,GLCD_LCD_HEIGHT - 1);
 	glcd_write();
+#endif
 }
 
 void glcd_clear_buffer(void) {
-	memset(glcd_buffer_selected, 0x00, GLCD_LCD_WIDTH * GLCD_LCD_HEIGHT / 8);
+	memset(glcd_buffer_selected, 0x00, GLCD_BUFFER_SIZE);
 	glcd_update_bbox(0,0,GLCD_LCD_WIDTH - 1,GLCD_LCD_HEIGHT - 1);
 }
 
+void glcd_render_area(const glcd_BoundingBox_t *area, void (*draw)(void))
+{
+#if defined(GLCD_USE_STRIP_BUFFER)
+	uint8_t page;
+	
+	if (area->y_min > area->y_max || area->x_min > area->x_max) {
+		return;
+	}
+	for (page = area->y_min / 8; page <= area->y_max / 8; page++) {
+		/* Replay the whole screen, only this page sticks */
+		glcd_strip_page = page;
+		memset(glcd_buffer_selected, 0x00, GLCD_BUFFER_SIZE);
+		draw();
+		*glcd_bbox_selected = *area;
+		glcd_write();
+	}
+#else
+	draw();
+	if (area->y_min <= area->y_max && area->x_min <= area->x_max) {
+		glcd_update_bbox(area->x_min, area->y_min, area->x_max, area->y_max);
+	}
+	glcd_write();
+#endif
+}
+
 void glcd_select_screen(uint8_t *buffer, glcd_BoundingBox_t *bbox)
 {
 	glcd_buffer_selected = buffer;
@@ -141,6 +180,8 @@ void glcd_scroll(int8_t x, int8_t y)
 	/** \todo Skeleton */
 	
 	uint8_t row;
+	(void)x;
+	(void)y;
 	
 	for (row=0; row<(GLCD_LCD_HEIGHT / 8); row++) {
 		uint8_t x;
@@ -150,6 +191,7 @@ void glcd_scroll(int8_t x, int8_t y)
 	}
 }
 
+#if !defined(GLCD_USE_STRIP_BUFFER)
 void glcd_scroll_line(void)
 {
 	uint8_t y;
@@ -165,4 +207,4 @@ void glcd_scroll_line(void)
 	}
 	glcd_update_bbox(0,0,GLCD_LCD_WIDTH - 1,GLCD_LCD_HEIGHT - 1);
 }
-
+#endif
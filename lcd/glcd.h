@@ -38,6 +38,8 @@
 #if defined(GLCD_DEVICE_CH32V003)
 #include "ch32v003fun/ch32v003fun.h"
 
+/* GLCD_USE_STRIP_BUFFER, replacing the frame buffer with a single page, comes from the build flags(-D) */
+
 
 #define GLCD_CONTROLLER_ST7565R
 #if defined(GLCD_CONTROLLER_PCD8544)
@@ -62,11 +64,18 @@
 
 /**
  * Font table type
+ *
+ * PACKED is a compact format produced by tools/fonts from MIKRO tables:
+ * - one little-endian uint16_t offset per glyph, from the start of the table
+ * - per glyph: advance width, first inked column, inked columns (w), first inked row, inked rows (h)
+ * - then w column bitmaps of (h+7)/8 bytes each, bit 0 being the first inked row
+ * Only the inked bounding box of each glyph is stored, all the zero padding is elided.
  */
 typedef enum {
 	STANG,
 	MIKRO,
-	GLCD_UTILS
+	GLCD_UTILS,
+	PACKED
 } font_table_type_t;
 
 /**
@@ -86,6 +95,8 @@ typedef struct {
 #include "glcd_graphs.h"
 #include "glcd_text_tiny.h"
 #include "glcd_text.h"
+#include "glcd_segments.h"
+#include "glcd_overlay.h"
 
 /**
  * \name Colour Constants
@@ -154,8 +165,36 @@ typedef struct {
 	#define GLCD_RESET_TIME 1
 #endif
 
+/**
+ * \name Screen buffer layout
+ * The buffer is organised in pages of 8 pixel rows, GLCD_LCD_WIDTH bytes each, bit 0 being the top row.
+ * With GLCD_USE_STRIP_BUFFER only one page is kept in RAM. Screens are then drawn through
+ * glcd_render_area(), which replays the drawing once per page, and every drawing function
+ * silently skips the pixels outside the page being rendered.
+ * @{
+ */
+#if defined(GLCD_USE_STRIP_BUFFER)
+	#define GLCD_BUFFER_SIZE GLCD_LCD_WIDTH
+	/** Page held in the buffer, set by glcd_render_area() */
+	extern uint8_t glcd_strip_page;
+	/** glcd_strip_page value with no page visible: drawing only grows the bounding box */
+	#define GLCD_STRIP_NONE 0xFF
+	/** Non-zero if the page is in the buffer and can be drawn to */
+	#define GLCD_PAGE_VISIBLE(page) ((page) == glcd_strip_page)
+	/** Pointer to the first byte of a page in the buffer. Only valid for visible pages */
+	#define GLCD_PAGE(page) (glcd_buffer_selected)
+	/** Offset of the buffer in a full frame */
+	#define GLCD_BUFFER_OFFSET ((uint16_t)glcd_strip_page * GLCD_LCD_WIDTH)
+#else
+	#define GLCD_BUFFER_SIZE (GLCD_LCD_WIDTH * GLCD_LCD_HEIGHT / 8)
+	#define GLCD_PAGE_VISIBLE(page) 1
+	#define GLCD_PAGE(page) (glcd_buffer_selected + (page)*GLCD_LCD_WIDTH)
+	#define GLCD_BUFFER_OFFSET 0u
+#endif
+/**@}*/
+
 /* Global variables used for GLCD library */
-extern uint8_t glcd_buffer[GLCD_LCD_WIDTH * GLCD_LCD_HEIGHT / 8];
+extern uint8_t glcd_buffer[GLCD_BUFFER_SIZE];
 extern glcd_BoundingBox_t glcd_bbox;
 extern uint8_t *glcd_buffer_selected;
 extern glcd_BoundingBox_t *glcd_bbox_selected;
@@ -203,6 +242,20 @@ void glcd_bbox_refresh(void);
  */
 void glcd_clear(void);
 
+/**
+ * Draw and send the part of the screen inside area.
+ *
+ * With the full frame buffer this is draw() followed by glcd_write() of area.
+ * With GLCD_USE_STRIP_BUFFER draw() is called once for every page area touches, on a cleared
+ * buffer holding only that page, and each page is sent to the LCD before the next one is drawn.
+ * draw() must therefore draw everything that can be on those pages and must not have any side
+ * effects other than drawing.
+ *
+ * \param area Rectangle to send to the LCD, typically what changed since the last frame
+ * \param draw Draws the screen
+ */
+void glcd_render_area(const glcd_BoundingBox_t *area, void (*draw)(void));
+
 /**
  * Clear the display buffer only. This does not physically write the changes to the LCD
  */
@@ -230,9 +283,12 @@ void glcd_scroll(int8_t x, int8_t y);
 /**
  * Scroll screen buffer up by 8 pixels.
  * This is designed to be used in conjunciton with tiny text functions which are 8 bits high.
+ * Not available with GLCD_USE_STRIP_BUFFER, there are no other pages to scroll in.
  * \see Tiny Text
  */
+#if !defined(GLCD_USE_STRIP_BUFFER)
 void glcd_scroll_line(void);
+#endif
 
 /** @}*/
 
@@ -243,8 +299,15 @@ typedef struct {
 	char start_char;
 	char end_char;
 	font_table_type_t table_type;
+	/** Sparse fonts: the glyph number in font_table of every character from start_char to end_char,
+	    GLCD_NO_GLYPH for the ones it leaves out. NULL for a table holding every one of them.
+	    Only glcd_draw_char_xy() and the string functions built on it look at it. */
+	const uint8_t *charmap;
 } glcd_FontConfig_t;
 
+/** glcd_FontConfig_t::charmap entry of a character the sparse font does not have */
+#define GLCD_NO_GLYPH 0xFF
+
 extern uint8_t *glcd_buffer_selected;
 extern glcd_BoundingBox_t *glcd_bbox_selected;
 extern glcd_FontConfig_t font_current;
@@ -69,12 +69,17 @@ void glcd_data(uint8_t c);
 void glcd_set_contrast(uint8_t val);
 
 /**
- * Power down the device.
+ * Power down the device. On the ST7565R/ST7567, display off plus all points on is the power save
+ * mode: oscillator, booster and regulators stop and the display RAM is kept. The controller then
+ * draws its standby current, a few uA per the datasheets, against the low hundreds of uA it draws
+ * with the booster running. The glass is blank.
  */
 void glcd_power_down(void);
 
 /**
- * Power up the device.
+ * Power up the device after glcd_power_down(). No reset pulse or init sequence is needed. The
+ * whole screen is added to the bounding box and, with a full frame buffer, sent again from RAM
+ * right away. With GLCD_USE_STRIP_BUFFER it is sent with the next render.
  */
 void glcd_power_up(void);
 
@@ -65,7 +65,29 @@ uint8_t glcd_get_pixel(uint8_t x, uint8_t y);
 void glcd_invert_pixel(uint8_t x, uint8_t y);
 
 /**
- * Draw line
+ * Draw horizontal line. Written as a single bit mask applied across columns.
+ * Pixels outside the display are clipped.
+ * \param x Start x-coordinate (left-most)
+ * \param y Y-coordinate
+ * \param w Width in pixels
+ * \param color Colour to set pixels
+ * \see ColourConstants
+ */
+void glcd_draw_hline(uint8_t x, uint8_t y, uint8_t w, uint8_t color);
+
+/**
+ * Draw vertical line. Written as one byte mask per page it crosses.
+ * Pixels outside the display are clipped.
+ * \param x X-coordinate
+ * \param y Start y-coordinate (top-most)
+ * \param h Height in pixels
+ * \param color Colour to set pixels
+ * \see ColourConstants
+ */
+void glcd_draw_vline(uint8_t x, uint8_t y, uint8_t h, uint8_t color);
+
+/**
+ * Draw line. Horizontal and vertical lines use glcd_draw_hline() / glcd_draw_vline().
  * \param x0 Start x-coordinate
  * \param y0 Start y-coordinate
  * \param x1 End x-coordinate
@@ -164,6 +186,16 @@ void glcd_invert_area(uint8_t x, uint8_t y, uint8_t w, uint8_t h);
  */
 void glcd_draw_bitmap(const unsigned char *data);
 
+/**
+ * Unpack a run-length encoded bitmap into the entire screen buffer.
+ * Data is in page order like glcd_draw_bitmap(), packed as a sequence of chunks:
+ * - header 0x00-0x7F: (header + 1) literal bytes follow
+ * - header 0x80-0xFF: the next byte is repeated (header - 0x80 + 2) times
+ * The stream must expand to exactly one full screen buffer.
+ * \param data Pointer to packed bitmap data.
+ */
+void glcd_draw_packed_bitmap(const unsigned char *data);
+
 /** @}*/
 
 #endif /* GLCD_GRAPHICS_H_ */
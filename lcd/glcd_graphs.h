@@ -83,6 +83,34 @@ void glcd_bar_graph_vertical_no_border(uint8_t x, uint8_t y, uint8_t width, uint
 /** \todo write doc */
 void glcd_scrolling_bar_graph(uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t val);
 
+/** Sweep graph: a bar chart that never moves a pixel.
+ *  Like an oscilloscope sweep, every new sample overwrites the oldest column and the blank
+ *  column after it marks where the sweep is, so adding a sample only rewrites two columns of
+ *  bytes instead of scrolling the whole chart. The samples are kept by whoever owns the data,
+ *  the graph only keeps where the sweep is and asks for the bar of each column it draws.
+ */
+typedef struct {
+	uint8_t (*bar)(uint8_t age); /**< Bar height in pixels of the newest sample(age 0), the one before, ... */
+	uint8_t size;                /**< Number of columns, also the chart width */
+	uint8_t head;                /**< Column the next sample goes into, drawn blank */
+} glcd_SweepGraph_t;
+
+/** A sample was added to the data behind a sweep graph, move on to the next column. Draws nothing.
+ *  \param graph graph to move
+ */
+void glcd_sweep_graph_advance(glcd_SweepGraph_t *graph);
+
+/** Draw the newest columns of a sweep graph. Each column is written as whole bytes, one per page.
+ *  \param x x location of the leftmost column
+ *  \param y y location of the top of the chart
+ *  \param height chart height, bars are clipped to it
+ *  \param graph graph to draw
+ *  \param count number of columns to draw, going back from the blank column at head.
+ *                graph->size draws the whole chart, 1 + the samples added since the last draw
+ *                brings it up to date
+ */
+void glcd_sweep_graph_draw(uint8_t x, uint8_t y, uint8_t height, const glcd_SweepGraph_t *graph, uint8_t count);
+
 /** @}*/
 
 #endif
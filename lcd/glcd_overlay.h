@@ -0,0 +1,84 @@
+/**
+   \file glcd_overlay.h
+   \brief GLCD Library - Rectangles combined with the frame buffer on its way to the LCD
+ */
+
+#ifndef GLCD_OVERLAY_H
+#define GLCD_OVERLAY_H
+
+/** \addtogroup Overlay Overlay
+ *  A short list of rectangles that glcd_write() ORs, XORs or clears into the bytes it sends.
+ *  The frame buffer itself is never changed, so blinking something is a matter of changing
+ *  the blink phase and sending the pages the overlay covers, without drawing anything.
+ *  With GLCD_USE_STRIP_BUFFER pages only go out through glcd_render_area(), so the areas
+ *  queued here are sent with the next render.
+ *  @{
+ */
+
+/** \name Overlay operations
+ *  @{
+ */
+#define GLCD_OVERLAY_OR    0 /**< Set the pixels of the rectangle */
+#define GLCD_OVERLAY_XOR   1 /**< Invert the pixels of the rectangle */
+#define GLCD_OVERLAY_CLEAR 2 /**< Clear the pixels of the rectangle */
+/**@}*/
+
+/** glcd_Overlay_t::phases value for an overlay that does not blink */
+#define GLCD_OVERLAY_ALWAYS 0xFF
+
+/** Most overlays glcd_set_overlays() takes */
+#define GLCD_MAX_OVERLAYS 4
+
+/** One overlay rectangle */
+typedef struct {
+	uint8_t x;      /**< Top-left x */
+	uint8_t y;      /**< Top-left y */
+	uint8_t w;      /**< Width in pixels */
+	uint8_t h;      /**< Height in pixels */
+	uint8_t op;     /**< GLCD_OVERLAY_OR, GLCD_OVERLAY_XOR or GLCD_OVERLAY_CLEAR */
+	uint8_t phases; /**< Bit n set: applied during blink phase n */
+} glcd_Overlay_t;
+
+/** An overlay cut to one page: the page bytes in x_min..x_max become (byte & keep) ^ flip */
+typedef struct {
+	uint8_t x_min;
+	uint8_t x_max;
+	uint8_t keep;
+	uint8_t flip;
+} glcd_OverlaySpan_t;
+
+/**
+ * Replace the overlay list. The areas of the old and the new overlays are added to the bounding box.
+ * \param overlays table of overlays, applied in table order. Must stay valid while in use
+ * \param count number of overlays, at most GLCD_MAX_OVERLAYS. 0 turns the overlay layer off
+ */
+void glcd_set_overlays(const glcd_Overlay_t *overlays, uint8_t count);
+
+/**
+ * Set the blink phase. The areas of the overlays that appear or disappear are added to the
+ * bounding box, so the next glcd_write() only sends those.
+ * \param phase 0 to 7
+ */
+void glcd_set_overlay_phase(uint8_t phase);
+
+/**
+ * Cut the overlays applied in the current phase to one page. Used by glcd_write().
+ * \param page page about to be sent
+ * \param spans room for GLCD_MAX_OVERLAYS spans
+ * \return number of spans filled, 0 if the page is sent as it is
+ */
+uint8_t glcd_overlay_spans(uint8_t page, glcd_OverlaySpan_t *spans);
+
+/**
+ * Apply the spans of a page to one of its bytes. Used by glcd_write().
+ * \param data byte from the frame buffer
+ * \param column its column
+ * \param spans spans from glcd_overlay_spans()
+ * \param count number of spans
+ * \return byte to send
+ */
+uint8_t glcd_overlay_apply(uint8_t data, uint8_t column, const glcd_OverlaySpan_t *spans, uint8_t count);
+
+/** @}*/
+
+#endif
@@ -0,0 +1,52 @@
+/**
+   \file glcd_segments.h
+   \brief GLCD Library - Seven-segment digits drawn from filled rectangles
+ */
+
+#ifndef GLCD_SEGMENTS_H
+#define GLCD_SEGMENTS_H
+
+/** \addtogroup Text
+ *  @{
+ */
+
+/** \addtogroup SegmentText Seven-segment Text
+ *  Large digits without a font table. Every segment is one glcd_fill_rect(), which writes
+ *  whole bytes once the segment edges sit on page boundaries.
+ *  @{
+ */
+
+/** Seven-segment digit geometry.
+ *  A digit cell is width x height. The top, middle and bottom segments are thickness rows
+ *  high, the side segments thickness columns wide. A decimal point takes a thickness wide cell.
+ */
+typedef struct {
+	uint8_t width;     /**< Digit cell width in pixels */
+	uint8_t height;    /**< Digit cell height in pixels */
+	uint8_t thickness; /**< Segment thickness in pixels */
+	uint8_t spacing;   /**< Blank columns after every cell */
+} glcd_SegmentStyle_t;
+
+/** Draw a fixed-point number as seven-segment digits.
+ *  With a previous value only the segments that differ from it are drawn, so unchanged digits
+ *  are not touched and the bounding box only covers what changed. Without one, or when the
+ *  length of the text changes, the area of the number is cleared and everything is drawn.
+ *  Characters other than digits, '-', '.' and ' ' are drawn blank.
+ *  Cells that start past the right edge are left out.
+ *  \param x x location of the top-left of the first cell
+ *  \param y y location of the top-left of the first cell
+ *  \param value number, with format->scale implied decimal digits
+ *  \param previous value currently on the screen at x,y with the same format, or NULL
+ *  \param format width, padding and decimals
+ *  \param style digit geometry
+ *  \return x location right after the last cell, or past the right edge where the cells stop
+ *  \see glcd_format_number()
+ */
+uint8_t glcd_draw_segment_number_xy(uint8_t x, uint8_t y, int32_t value, const int32_t *previous,
+	const glcd_NumberFormat_t *format, const glcd_SegmentStyle_t *style);
+
+/** @}*/
+
+/** @}*/
+
+#endif
@@ -102,6 +102,44 @@ void glcd_draw_string_xy(uint8_t x, uint8_t y, char *c);
  */
 void glcd_draw_string_xy_P(uint8_t x, uint8_t y, const char *str);
 
+/** \name Number format flags
+ *  \see glcd_NumberFormat_t
+ *  @{
+ */
+#define GLCD_NUMBER_ZERO_PAD 0x01 /**< Pad to the width with '0' after the sign instead of leading spaces */
+#define GLCD_NUMBER_UNSIGNED 0x02 /**< The value is a uint32_t */
+/**@}*/
+
+/** Longest number glcd_draw_number_xy() draws, padding included */
+#define GLCD_NUMBER_MAX_WIDTH 16
+
+/** Fixed-point number format for glcd_draw_number_xy() */
+typedef struct {
+	uint8_t width;    /**< Minimum number of characters, sign and point included */
+	uint8_t scale;    /**< Decimal digits implied in the value, e.g. 1 for a value in tenths */
+	uint8_t decimals; /**< Decimal digits shown, up to scale. The others are cut off */
+	uint8_t flags;    /**< GLCD_NUMBER_ZERO_PAD, GLCD_NUMBER_UNSIGNED */
+} glcd_NumberFormat_t;
+
+/** Format a fixed-point number into a string, without going through printf.
+ *  Digits are extracted with shifts and adds only, so no software division is needed.
+ *  \param str buffer of GLCD_NUMBER_MAX_WIDTH + 1 chars, filled from the end
+ *  \param value number, with format->scale implied decimal digits
+ *  \param format width, padding and decimals
+ *  \return pointer to the first character, the string is NUL terminated at str[GLCD_NUMBER_MAX_WIDTH]
+ */
+char *glcd_format_number(char *str, int32_t value, const glcd_NumberFormat_t *format);
+
+/** Draw a fixed-point number at specified location, without going through printf.
+ *  \param x x location to place top-left of the first character frame
+ *  \param y y location to place top-left of the first character frame
+ *  \param value number, with format->scale implied decimal digits
+ *  \param format width, padding and decimals
+ *  \return x location right after the last character drawn
+ *  \see glcd_format_number()
+ */
+uint8_t glcd_draw_number_xy(uint8_t x, uint8_t y, int32_t value, const glcd_NumberFormat_t *format);
+
 /** @}*/
 
 /** @}*/
@@ -89,12 +89,15 @@ void glcd_tiny_draw_string_P(uint8_t x, uint8_t line, const char *str);
 
 /** Write string to bottom row of display.
  *  Screen buffer is scrolled up by one line. Screen is then physically updated.
+ *  Not available with GLCD_USE_STRIP_BUFFER.
  *  \param str string to be written
  */
+#if !defined(GLCD_USE_STRIP_BUFFER)
 void glcd_tiny_draw_string_ammend(char *str);
 
 /** Write string from flash memory to bottom row of display.
  *  Screen buffer is scrolled up by one line. Screen is then physically updated.
+ *  Not available with GLCD_USE_STRIP_BUFFER.
  *  \param str string to be written
  */
 #if defined(GLCD_DEVICE_AVR8)
@@ -102,6 +105,7 @@ void glcd_tiny_draw_string_ammend_P(PGM_P str);
 #else
 void glcd_tiny_draw_string_ammend_P(const char *str);
 #endif
+#endif
 
 /**
  * Invert all contents of line number. Line 0 is the top most line.
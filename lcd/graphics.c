@@ -49,24 +49,27 @@ void glcd_set_pixel(uint8_t x, uint8_t y, uint8_t color) {
 		return;
 	}
 
+	glcd_update_bbox(x,y,x,y);
+	if (!GLCD_PAGE_VISIBLE(y/8)) {
+		return;
+	}
+
 	if (color) {
 		/* Set black */
-		glcd_buffer[x+ (y/8)*GLCD_LCD_WIDTH] |= ( 1 << (y%8));
+		GLCD_PAGE(y/8)[x] |= ( 1 << (y%8));
 	} else {
 		/* Set white */
-		glcd_buffer[x+ (y/8)*GLCD_LCD_WIDTH] &= ~ (1 << (y%8));
+		GLCD_PAGE(y/8)[x] &= ~ (1 << (y%8));
 	}
-
-	glcd_update_bbox(x,y,x,y);
 }
 
 /* Based on PCD8544 library by Limor Fried */
 uint8_t glcd_get_pixel(uint8_t x, uint8_t y) {
-	if ((x >= GLCD_LCD_WIDTH) || (y >= GLCD_LCD_HEIGHT)) {
+	if ((x >= GLCD_LCD_WIDTH) || (y >= GLCD_LCD_HEIGHT) || !GLCD_PAGE_VISIBLE(y/8)) {
 		return 0;
 	}
 	
-	if ( glcd_buffer[x+ (y/8)*GLCD_LCD_WIDTH] & ( 1 << (y%8)) ) {
+	if ( GLCD_PAGE(y/8)[x] & ( 1 << (y%8)) ) {
 		return 1;
 	} else {
 		return 0;
@@ -78,7 +81,87 @@ void glcd_invert_pixel(uint8_t x, uint8_t y) {
 		return;
 	}
 	glcd_update_bbox(x,y,x,y);
-	glcd_buffer[x+ (y/8)*GLCD_LCD_WIDTH] ^= ( 1 << (y%8));
+	if (GLCD_PAGE_VISIBLE(y/8)) {
+		GLCD_PAGE(y/8)[x] ^= ( 1 << (y%8));
+	}
+}
+
+/*
+ * Apply a bit mask to one page (8 pixel rows) over columns x0..x1 inclusive.
+ * All the span and rectangle kernels below end up here, so a filled area costs
+ * one read-modify-write per touched byte instead of one glcd_set_pixel() per pixel.
+ * Coordinates must already be clipped to the display. Pages outside the strip buffer are skipped.
+ */
+static void glcd_fill_page_span(uint8_t page, uint8_t x0, uint8_t x1, uint8_t mask, uint8_t color)
+{
+	uint8_t *p = &GLCD_PAGE(page)[x0];
+	uint8_t *end = p + (x1 - x0);
+
+	if (!GLCD_PAGE_VISIBLE(page)) {
+		return;
+	}
+
+	if (color) {
+		for (; p <= end; p++) *p |= mask;
+	} else {
+		mask = ~mask;
+		for (; p <= end; p++) *p &= mask;
+	}
+}
+
+/* Fill the clipped rectangle x0..x1, y0..y1 (inclusive) page by page */
+static void glcd_fill_area(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t color)
+{
+	uint8_t page = y0 / 8;
+	uint8_t last_page = y1 / 8;
+
+	glcd_update_bbox(x0, y0, x1, y1);
+
+	for (; page <= last_page; page++) {
+		uint8_t mask = 0xFF;
+		if (page == y0 / 8) {
+			mask &= (uint8_t)(0xFF << (y0 % 8));
+		}
+		if (page == last_page) {
+			mask &= (uint8_t)(0xFF >> (7 - (y1 % 8)));
+		}
+		glcd_fill_page_span(page, x0, x1, mask, color);
+	}
+}
+
+/* Clip a start coordinate and length to [0, limit-1]; returns 0 if nothing is visible */
+static uint8_t glcd_clip_span(uint8_t start, uint16_t len, uint8_t limit, uint8_t *end)
+{
+	if (start >= limit || len == 0) {
+		return 0;
+	}
+	if (start + len - 1 >= limit) {
+		*end = limit - 1;
+	} else {
+		*end = start + len - 1;
+	}
+	return 1;
+}
+
+void glcd_draw_hline(uint8_t x, uint8_t y, uint8_t w, uint8_t color)
+{
+	uint8_t x1;
+
+	if (y >= GLCD_LCD_HEIGHT || !glcd_clip_span(x, w, GLCD_LCD_WIDTH, &x1)) {
+		return;
+	}
+	glcd_update_bbox(x, y, x1, y);
+	glcd_fill_page_span(y / 8, x, x1, (uint8_t)(1 << (y % 8)), color);
+}
+
+void glcd_draw_vline(uint8_t x, uint8_t y, uint8_t h, uint8_t color)
+{
+	uint8_t y1;
+
+	if (x >= GLCD_LCD_WIDTH || !glcd_clip_span(y, h, GLCD_LCD_HEIGHT, &y1)) {
+		return;
+	}
+	glcd_fill_area(x, y, x, y1, color);
 }
 
 /* Bresenham's algorithm - based on PCD8544 library Limor Fried */
@@ -87,6 +170,18 @@ void glcd_draw_line(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t colo
 	uint8_t dx, dy;
 	int8_t err;
 	int8_t ystep;
+
+	/* Axis-aligned lines go straight to the span kernels */
+	if (x0 == x1) {
+		uint16_t len = abs(y1 - y0) + 1;
+		glcd_draw_vline(x0, (y0 < y1) ? y0 : y1, (len > 0xFF) ? 0xFF : len, color);
+		return;
+	}
+	if (y0 == y1) {
+		uint16_t len = abs(x1 - x0) + 1;
+		glcd_draw_hline((x0 < x1) ? x0 : x1, y0, (len > 0xFF) ? 0xFF : len, color);
+		return;
+	}
 	
 	if (steep) {
 		swap(x0, y0);
@@ -127,34 +222,27 @@ void glcd_draw_line(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t colo
 
 void glcd_fill_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color)
 {
-	int16_t i;
-	for (i=x; i<x+w; i++) {
-		int16_t j;
-		for (j=y; j<y+h; j++) {
-			glcd_set_pixel(i, j, color);
-		}
+	uint8_t x1, y1;
+
+	if (!glcd_clip_span(x, w, GLCD_LCD_WIDTH, &x1) || !glcd_clip_span(y, h, GLCD_LCD_HEIGHT, &y1)) {
+		return;
 	}
-	glcd_update_bbox(x, y, x+w-1, y+h-1);
+	glcd_fill_area(x, y, x1, y1, color);
 }
 
 void glcd_draw_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color)
 {
-	int16_t i;
-	for (i=x; i<x+w; i++) {
-		glcd_set_pixel(i, y, color);
-		glcd_set_pixel(i, y+h-1, color);
-	}
-	for (i=y; i<y+h; i++) {
-		glcd_set_pixel(x, i, color);
-		glcd_set_pixel(x+w-1, i, color);
-	} 
-	glcd_update_bbox(x, y, x+w-1, y+h-1);
+	if (w == 0 || h == 0) {
+		return;
+	}
+	glcd_draw_hline(x, y, w, color);
+	glcd_draw_hline(x, y+h-1, w, color);
+	glcd_draw_vline(x, y, h, color);
+	glcd_draw_vline(x+w-1, y, h, color);
 }
 
 void glcd_draw_rect_thick(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t tx, uint8_t ty, uint8_t color)
 {
-	int16_t i, t;
-	
 	if (tx == 0) {
 		tx = 1;
 	}
@@ -162,22 +250,25 @@ void glcd_draw_rect_thick(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t tx
 	if (ty == 0) {
 		ty = 1;
 	}
+
+	if (w == 0 || h == 0) {
+		return;
+	}
 	
-	for (i=x; i<x+w; i++) {
-		/* Top and bottom sides */
-		for (t=0; t<(ty); t++) {
-			glcd_set_pixel(i, y+t, color);
-			glcd_set_pixel(i, y+h-1-t, color);
-		}
+	/* Top and bottom sides. A side thicker than the rectangle sticks out past its far edge, clipped at 0 */
+	glcd_fill_rect(x, y, w, ty, color);
+	if (y + h >= ty) {
+		glcd_fill_rect(x, y+h-ty, w, ty, color);
+	} else {
+		glcd_fill_rect(x, 0, w, y+h, color);
+	}
+	/* Left and right sides */
+	glcd_fill_rect(x, y, tx, h, color);
+	if (x + w >= tx) {
+		glcd_fill_rect(x+w-tx, y, tx, h, color);
+	} else {
+		glcd_fill_rect(0, y, x+w, h, color);
 	}
-	for (i=y; i<y+h; i++) {
-		/* Left and right sides */
-		for (t=0; t<(tx); t++) {
-			glcd_set_pixel(x+t, i, color);
-			glcd_set_pixel(x+w-1-t, i, color);
-		}
-	} 
-	glcd_update_bbox(x, y, x+w-1, y+h-1);
 }
 
 void glcd_draw_rect_shadow(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color)
@@ -300,10 +391,48 @@ void glcd_draw_bitmap(const unsigned char *data)
 	
 	/* Copy bitmap data to the screen buffer */
 #if defined(GLCD_DEVICE_AVR8)
-	memcpy_P(glcd_buffer_selected, data, (GLCD_LCD_WIDTH * GLCD_LCD_HEIGHT / 8));
+	memcpy_P(glcd_buffer_selected, data + GLCD_BUFFER_OFFSET, GLCD_BUFFER_SIZE);
 #else
-	memcpy(glcd_buffer_selected, data, (GLCD_LCD_WIDTH * GLCD_LCD_HEIGHT / 8));
+	memcpy(glcd_buffer_selected, data + GLCD_BUFFER_OFFSET, GLCD_BUFFER_SIZE);
 #endif
 
 	glcd_bbox_refresh(); 
 }
+
+void glcd_draw_packed_bitmap(const unsigned char *data)
+{
+	/* Frame offsets: the stream is decoded from 0, only first..end lands in the buffer */
+	uint16_t pos = 0;
+	uint16_t first = GLCD_BUFFER_OFFSET;
+	uint16_t end = first + GLCD_BUFFER_SIZE;
+
+	while (pos < end) {
+		uint8_t n = *data++;
+		const unsigned char *literal = NULL;
+		uint8_t value = 0;
+		if (n & 0x80) {
+			/* Run: next byte repeated (n & 0x7F) + 2 times */
+			n = (n & 0x7F) + 2;
+			value = *data++;
+		} else {
+			/* Literal: next n + 1 bytes copied as they are */
+			n = n + 1;
+			literal = data;
+			data += n;
+		}
+
+		if (pos + n > first) {
+			/* Keep the part inside the buffer */
+			uint16_t from = (pos > first) ? pos : first;
+			uint16_t to = (pos + n < end) ? pos + n : end;
+			if (literal != NULL) {
+				memcpy(glcd_buffer_selected + (from - first), literal + (from - pos), to - from);
+			} else {
+				memset(glcd_buffer_selected + (from - first), value, to - from);
+			}
+		}
+		pos += n;
+	}
+
+	glcd_bbox_refresh();
+}
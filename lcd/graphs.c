@@ -114,6 +114,65 @@ void glcd_scrolling_bar_graph_timing(uint8_t x, uint8_t y, uint8_t width, uint8_
 	}
 }
 
+void glcd_sweep_graph_advance(glcd_SweepGraph_t *graph)
+{
+	if (++graph->head >= graph->size) {
+		graph->head = 0;
+	}
+}
+
+/* Bits of a page byte that fall in rows first..last, 0 if none */
+static uint8_t glcd_page_rows_mask(uint8_t page, uint8_t first, uint8_t last)
+{
+	uint8_t top = page * 8;
+	uint8_t mask = 0xFF;
+
+	if (first > top + 7 || last < top) {
+		return 0;
+	}
+	if (first > top) {
+		mask &= (uint8_t)(0xFF << (first - top));
+	}
+	if (last < top + 7) {
+		mask &= (uint8_t)(0xFF >> (top + 7 - last));
+	}
+	return mask;
+}
+
+void glcd_sweep_graph_draw(uint8_t x, uint8_t y, uint8_t height, const glcd_SweepGraph_t *graph, uint8_t count)
+{
+	uint8_t bottom = y + height - 1;
+	uint8_t column = graph->head;
+	uint8_t bar = 0; /* The head column is the blank sweep marker */
+	uint8_t age = 0;
+
+	if (height == 0 || bottom >= GLCD_LCD_HEIGHT) {
+		return;
+	}
+	
+	for (; count; count--) {
+		uint8_t page;
+		
+		if (bar > height) {
+			bar = height;
+		}
+		for (page = y / 8; page <= bottom / 8 && x + column < GLCD_LCD_WIDTH; page++) {
+			uint8_t area = glcd_page_rows_mask(page, y, bottom);
+			uint8_t filled = bar ? glcd_page_rows_mask(page, bottom - bar + 1, bottom) : 0;
+			
+			if (GLCD_PAGE_VISIBLE(page)) {
+				uint8_t *p = &GLCD_PAGE(page)[x + column];
+				*p = (*p & ~area) | filled;
+			}
+		}
+		glcd_update_bbox(x + column, y, x + column, bottom);
+		
+		/* Walk back towards the older samples */
+		column = column ? column - 1 : graph->size - 1;
+		bar = (count > 1) ? graph->bar(age++) : 0;
+	}
+}
+
 static uint8_t glcd_map(uint8_t x1, uint8_t x2, uint8_t x)
 {
 	return x1+(x2-x1)*x/255;	
@@ -0,0 +1,111 @@
+/**
+   \file overlay.c
+   \brief GLCD Library - Rectangles combined with the frame buffer on its way to the LCD
+ */
+
+#include <stddef.h>
+#include "glcd.h"
+
+static const glcd_Overlay_t *glcd_overlays;
+static uint8_t glcd_overlay_count;
+static uint8_t glcd_overlay_phase_mask = 0x01;
+
+/* Add the area of every overlay active in one of the phases in mask to the bounding box */
+static void glcd_overlay_mark(uint8_t mask)
+{
+	const glcd_Overlay_t *overlay = glcd_overlays;
+	uint8_t i;
+
+	for (i = 0; i < glcd_overlay_count; i++, overlay++) {
+		if ((overlay->phases & mask) && overlay->w && overlay->h) {
+			glcd_update_bbox(overlay->x, overlay->y, overlay->x + overlay->w - 1, overlay->y + overlay->h - 1);
+		}
+	}
+}
+
+void glcd_set_overlays(const glcd_Overlay_t *overlays, uint8_t count)
+{
+	if (count > GLCD_MAX_OVERLAYS) {
+		count = GLCD_MAX_OVERLAYS;
+	}
+	if (overlays == glcd_overlays && count == glcd_overlay_count) {
+		return;
+	}
+	glcd_overlay_mark(glcd_overlay_phase_mask);
+	glcd_overlays = overlays;
+	glcd_overlay_count = count;
+	glcd_overlay_mark(glcd_overlay_phase_mask);
+}
+
+void glcd_set_overlay_phase(uint8_t phase)
+{
+	uint8_t mask = 1 << (phase & 0x07);
+	const glcd_Overlay_t *overlay = glcd_overlays;
+	uint8_t i;
+
+	if (mask == glcd_overlay_phase_mask) {
+		return;
+	}
+	/* Only the overlays that come or go need sending */
+	for (i = 0; i < glcd_overlay_count; i++, overlay++) {
+		if (!(overlay->phases & mask) != !(overlay->phases & glcd_overlay_phase_mask) && overlay->w && overlay->h) {
+			glcd_update_bbox(overlay->x, overlay->y, overlay->x + overlay->w - 1, overlay->y + overlay->h - 1);
+		}
+	}
+	glcd_overlay_phase_mask = mask;
+}
+
+uint8_t glcd_overlay_spans(uint8_t page, glcd_OverlaySpan_t *spans)
+{
+	const glcd_Overlay_t *overlay = glcd_overlays;
+	uint8_t top = page * 8;
+	uint8_t count = 0;
+	uint8_t i;
+
+	for (i = 0; i < glcd_overlay_count; i++, overlay++) {
+		uint8_t mask = 0xFF;
+		uint16_t bottom = (uint16_t)overlay->y + overlay->h; /* First row below the overlay */
+
+		if (!(overlay->phases & glcd_overlay_phase_mask) || overlay->w == 0 ||
+		    overlay->y >= top + 8 || bottom <= top) {
+			continue;
+		}
+		if (overlay->y > top) {
+			mask &= (uint8_t)(0xFF << (overlay->y - top));
+		}
+		if (bottom < top + 8) {
+			mask &= (uint8_t)(0xFF >> (top + 8 - bottom));
+		}
+
+		spans->x_min = overlay->x;
+		spans->x_max = (overlay->x + overlay->w - 1 > GLCD_LCD_WIDTH - 1) ? GLCD_LCD_WIDTH - 1 : overlay->x + overlay->w - 1;
+		/* Every operation is (byte & keep) ^ flip */
+		switch (overlay->op) {
+			case GLCD_OVERLAY_OR:
+				spans->keep = ~mask;
+				spans->flip = mask;
+				break;
+			case GLCD_OVERLAY_XOR:
+				spans->keep = 0xFF;
+				spans->flip = mask;
+				break;
+			default:
+				spans->keep = ~mask;
+				spans->flip = 0;
+				break;
+		}
+		spans++;
+		count++;
+	}
+	return count;
+}
+
+uint8_t glcd_overlay_apply(uint8_t data, uint8_t column, const glcd_OverlaySpan_t *spans, uint8_t count)
+{
+	for (; count; count--, spans++) {
+		if (column >= spans->x_min && column <= spans->x_max) {
+			data = (data & spans->keep) ^ spans->flip;
+		}
+	}
+	return data;
+}
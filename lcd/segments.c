@@ -0,0 +1,119 @@
+/**
+   \file segments.c
+   \brief GLCD Library - Seven-segment digits drawn from filled rectangles
+ */
+
+#include <stddef.h>
+#include "glcd.h"
+
+/* Segment bits, the usual a-g naming clockwise from the top, plus the decimal point */
+#define SEG_A  0x01
+#define SEG_B  0x02
+#define SEG_C  0x04
+#define SEG_D  0x08
+#define SEG_E  0x10
+#define SEG_F  0x20
+#define SEG_G  0x40
+#define SEG_DP 0x80
+
+static const uint8_t glcd_segment_digits[10] = {
+	SEG_A | SEG_B | SEG_C | SEG_D | SEG_E | SEG_F,         /* 0 */
+	SEG_B | SEG_C,                                         /* 1 */
+	SEG_A | SEG_B | SEG_D | SEG_E | SEG_G,                 /* 2 */
+	SEG_A | SEG_B | SEG_C | SEG_D | SEG_G,                 /* 3 */
+	SEG_B | SEG_C | SEG_F | SEG_G,                         /* 4 */
+	SEG_A | SEG_C | SEG_D | SEG_F | SEG_G,                 /* 5 */
+	SEG_A | SEG_C | SEG_D | SEG_E | SEG_F | SEG_G,         /* 6 */
+	SEG_A | SEG_B | SEG_C,                                 /* 7 */
+	SEG_A | SEG_B | SEG_C | SEG_D | SEG_E | SEG_F | SEG_G, /* 8 */
+	SEG_A | SEG_B | SEG_C | SEG_D | SEG_F | SEG_G,         /* 9 */
+};
+
+static uint8_t glcd_segment_mask(char c)
+{
+	if (c >= '0' && c <= '9') {
+		return glcd_segment_digits[c - '0'];
+	}
+	if (c == '-') {
+		return SEG_G;
+	}
+	if (c == '.') {
+		return SEG_DP;
+	}
+	return 0;
+}
+
+static uint8_t glcd_segment_cell_width(char c, const glcd_SegmentStyle_t *style)
+{
+	return ((c == '.') ? style->thickness : style->width) + style->spacing;
+}
+
+/* Past the right edge it is all clipped anyway, so the width stops at 255 instead of wrapping */
+static uint8_t glcd_segment_text_width(const char *p, const glcd_SegmentStyle_t *style)
+{
+	uint16_t w = 0;
+
+	for (; *p; p++) {
+		w += glcd_segment_cell_width(*p, style);
+	}
+	return (w > 0xFF) ? 0xFF : w;
+}
+
+/*
+ * Fill the given segments of the cell at x,y. The segments never overlap, so lit and unlit
+ * ones can be drawn in any order: the side segments own the outer corners, the middle one
+ * spans the full width and the top and bottom ones sit between the sides.
+ */
+static void glcd_fill_segments(uint8_t x, uint8_t y, uint8_t segments, uint8_t color, const glcd_SegmentStyle_t *style)
+{
+	uint8_t t = style->thickness;
+	uint8_t w = style->width;
+	uint8_t h = style->height;
+	uint8_t mid = (h - t) / 2;      /* First row of the middle segment */
+	uint8_t low = h - mid - t;      /* Height of the lower side segments */
+
+	if (segments & SEG_A)  glcd_fill_rect(x + t, y, w - 2 * t, t, color);
+	if (segments & SEG_B)  glcd_fill_rect(x + w - t, y, t, mid, color);
+	if (segments & SEG_C)  glcd_fill_rect(x + w - t, y + mid + t, t, low, color);
+	if (segments & SEG_D)  glcd_fill_rect(x + t, y + h - t, w - 2 * t, t, color);
+	if (segments & SEG_E)  glcd_fill_rect(x, y + mid + t, t, low, color);
+	if (segments & SEG_F)  glcd_fill_rect(x, y, t, mid, color);
+	if (segments & SEG_G)  glcd_fill_rect(x, y + mid, w, t, color);
+	if (segments & SEG_DP) glcd_fill_rect(x, y + h - t, t, t, color);
+}
+
+uint8_t glcd_draw_segment_number_xy(uint8_t x, uint8_t y, int32_t value, const int32_t *previous,
+	const glcd_NumberFormat_t *format, const glcd_SegmentStyle_t *style)
+{
+	char str[GLCD_NUMBER_MAX_WIDTH + 1];
+	char old_str[GLCD_NUMBER_MAX_WIDTH + 1];
+	char *p = glcd_format_number(str, value, format);
+	char *old = NULL;
+
+	if (previous != NULL) {
+		old = glcd_format_number(old_str, *previous, format);
+		if (old - old_str != p - str) {
+			/* The cells moved, wipe the old number and start over */
+			glcd_fill_rect(x, y, glcd_segment_text_width(old, style), style->height, WHITE);
+			old = NULL;
+		}
+	}
+	if (old == NULL) {
+		glcd_fill_rect(x, y, glcd_segment_text_width(p, style), style->height, WHITE);
+	}
+
+	/* Only the segments that changed state are written */
+	/* Cells from the right edge on are not drawn, x would wrap round onto the left of the screen */
+	for (; *p && x < GLCD_LCD_WIDTH; p++) {
+		uint8_t segments = glcd_segment_mask(*p);
+		uint8_t changed = segments;
+
+		if (old != NULL) {
+			changed ^= glcd_segment_mask(*old++);
+		}
+		glcd_fill_segments(x, y, changed & segments, BLACK, style);
+		glcd_fill_segments(x, y, changed & ~segments, WHITE, style);
+		x += glcd_segment_cell_width(*p, style);
+	}
+	return x;
+}
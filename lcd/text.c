@@ -33,6 +33,7 @@
 	SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <stddef.h>
 #include "glcd.h"
 
 extern uint8_t *glcd_buffer_selected;
@@ -51,6 +52,7 @@ void glcd_set_font(const char * font_table, uint8_t width, uint8_t height, char
 	font_current.start_char = start_char;
 	font_current.end_char = end_char;
 	font_current.table_type = MIKRO; /* Only supports MikroElektronika generated format at the moment */
+	font_current.charmap = NULL;
 }
 
 #if defined(GLCD_DEVICE_AVR8)
@@ -66,12 +68,32 @@ void glcd_font(const char * font_table, uint8_t width, uint8_t height, char star
 	font_current.start_char = start_char;
 	font_current.end_char = end_char;
 	font_current.table_type = type; /* Only supports MikroElektronika generated format at the moment */
+	font_current.charmap = NULL;
 }
 
-uint8_t glcd_draw_char_xy(uint8_t x, uint8_t y, char c)
+/* Glyph number of c in the current font table, or -1 if the font has no glyph for it */
+static int16_t glcd_glyph_index(char c)
 {
 	if (c < font_current.start_char || c > font_current.end_char) {
-		c = '.';
+		return -1;
+	}
+	if (font_current.charmap != NULL) {
+		/* Sparse font, the charmap gives the glyph number */
+		uint8_t index = font_current.charmap[(uint8_t)(c - font_current.start_char)];
+		return (index == GLCD_NO_GLYPH) ? -1 : index;
+	}
+	return (uint8_t)(c - font_current.start_char);
+}
+
+uint8_t glcd_draw_char_xy(uint8_t x, uint8_t y, char c)
+{
+	int16_t index = glcd_glyph_index(c);
+	if (index < 0) {
+		/* Characters the font does not have are drawn as '.' */
+		index = glcd_glyph_index('.');
+		if (index < 0) {
+			return 0;
+		}
 	}
 	
 	if (font_current.table_type == STANG) {
@@ -81,9 +103,9 @@ uint8_t glcd_draw_char_xy(uint8_t x, uint8_t y, char c)
 		uint8_t i;
 		for ( i = 0; i < font_current.width; i++ ) {
 #if defined(GLCD_DEVICE_AVR8)			
-			uint8_t dat = pgm_read_byte( font_current.font_table + ((c - font_current.start_char) * (font_current.width)) + i );
+			uint8_t dat = pgm_read_byte( font_current.font_table + (index * font_current.width) + i );
 #else
-			uint8_t dat = *( font_current.font_table + ((c - font_current.start_char) * (font_current.width)) + i );
+			uint8_t dat = *( font_current.font_table + (index * font_current.width) + i );
 #endif
 			uint8_t j;
 			for (j = 0; j < 8; j++) {
@@ -124,7 +146,7 @@ uint8_t glcd_draw_char_xy(uint8_t x, uint8_t y, char c)
 		}
 		bytes_per_char = font_current.width * bytes_high + 1; /* The +1 is the width byte at the start */
 				
-		p = font_current.font_table + (c - font_current.start_char) * bytes_per_char;
+		p = font_current.font_table + index * bytes_per_char;
 
 		/* The first byte per character is always the width of the character */
 #if defined(GLCD_DEVICE_AVR8)		
@@ -172,6 +194,50 @@ uint8_t glcd_draw_char_xy(uint8_t x, uint8_t y, char c)
 		}
 		return var_width;	
 	
+	} else if (font_current.table_type == PACKED) {
+		/* Packed format, see font_table_type_t
+		   - the whole character cell is cleared first, like MIKRO writes white pixels
+		   - then only the inked bytes are OR'ed into the buffer, a byte lands in at most 2 pages */
+		
+		const uint8_t *table = (const uint8_t *)font_current.font_table;
+		const uint8_t *p;
+		uint8_t var_width, x0, w, y0, bytes_high;
+		uint8_t i;
+		
+		p = table + (table[index*2] | (table[index*2 + 1] << 8));
+		var_width = p[0];
+		x0 = p[1];
+		w = p[2];
+		y0 = p[3];
+		bytes_high = (p[4] + 7) / 8;
+		p += 5;
+		
+		if (x+var_width > GLCD_LCD_WIDTH || y+font_current.height > GLCD_LCD_HEIGHT) {
+			/* Don't write past the dimensions of the LCD, skip the entire char */
+			return 0;
+		}
+		
+		glcd_fill_rect(x, y, var_width, font_current.height, WHITE);
+		
+		for ( i = 0; i < w; i++ ) {
+			uint8_t column = x + x0 + i;
+			uint8_t j;
+			for ( j = 0; j < bytes_high; j++ ) {
+				uint8_t dat = *p++;
+				uint8_t row = y + y0 + j*8;
+				uint8_t page = row / 8;
+				uint8_t shift = row % 8;
+				
+				if (GLCD_PAGE_VISIBLE(page)) {
+					GLCD_PAGE(page)[column] |= dat << shift;
+				}
+				if (shift && (page + 1) < (GLCD_LCD_HEIGHT / 8) && GLCD_PAGE_VISIBLE(page + 1)) {
+					GLCD_PAGE(page + 1)[column] |= dat >> (8 - shift);
+				}
+			}
+		}
+		return var_width;
+		
 	} else if (font_current.table_type == GLCD_UTILS) {
 		/* Font table format of glcd-utils
 		   - A complete row is written first (not completed columns)
@@ -187,7 +253,7 @@ uint8_t glcd_draw_char_xy(uint8_t x, uint8_t y, char c)
 		bytes_per_char = font_current.width * bytes_high;
 		
 		/* Point to chars first byte */
-		p = font_current.font_table + (c - font_current.start_char) * bytes_per_char;
+		p = font_current.font_table + index * bytes_per_char;
 
 		/* Determine the width of the character */
 		var_width = font_current.width;
@@ -308,3 +374,85 @@ void glcd_draw_string_xy_P(uint8_t x, uint8_t y, const char *str)
 	}		
 }
 
+/* n / 10 with shifts and adds, the CH32V003 has neither a divider nor a multiplier */
+static uint32_t glcd_div10(uint32_t n, uint8_t *rem)
+{
+	uint32_t q = (n >> 1) + (n >> 2); /* n * 0.75, refined below towards n * 0.8 */
+	uint32_t r;
+	
+	q += q >> 4;
+	q += q >> 8;
+	q += q >> 16;
+	q >>= 3;
+	r = n - ((q << 3) + (q << 1)); /* At most one 10 off */
+	if (r > 9) {
+		q++;
+		r -= 10;
+	}
+	*rem = r;
+	return q;
+}
+
+char *glcd_format_number(char *str, int32_t value, const glcd_NumberFormat_t *format)
+{
+	char *p = str + GLCD_NUMBER_MAX_WIDTH;
+	uint32_t n = value;
+	uint8_t negative = 0;
+	uint8_t rem, i, len;
+	
+	*p = '\0';
+	if (!(format->flags & GLCD_NUMBER_UNSIGNED) && value < 0) {
+		negative = 1;
+		n = -(uint32_t)value;
+	}
+	/* Cut off the decimals that are not shown */
+	for (i = format->decimals; i < format->scale; i++) {
+		n = glcd_div10(n, &rem);
+	}
+	if (n == 0) {
+		/* No "-0" */
+		negative = 0;
+	}
+	
+	/* Digits come out least significant first, fill the string from the end */
+	i = 0;
+	do {
+		n = glcd_div10(n, &rem);
+		*--p = '0' + rem;
+		if (++i == format->decimals) {
+			*--p = '.';
+		}
+	} while (n || i <= format->decimals);
+	
+	len = str + GLCD_NUMBER_MAX_WIDTH - p + negative;
+	if (format->flags & GLCD_NUMBER_ZERO_PAD) {
+		/* Room left for the sign only if there is one */
+		for (; len < format->width && p > str + negative; len++) {
+			*--p = '0';
+		}
+	}
+	if (negative) {
+		*--p = '-';
+	}
+	for (; len < format->width && p > str; len++) {
+		*--p = ' ';
+	}
+	return p;
+}
+
+uint8_t glcd_draw_number_xy(uint8_t x, uint8_t y, int32_t value, const glcd_NumberFormat_t *format)
+{
+	char str[GLCD_NUMBER_MAX_WIDTH + 1];
+	char *p;
+	
+	if (y > (GLCD_LCD_HEIGHT - font_current.height - 1)) {
+		/* Character won't fit */
+		return x;
+	}
+	
+	/* Straight to the glyphs, like glcd_draw_string_xy() */
+	for (p = glcd_format_number(str, value, format); *p; p++) {
+		x += glcd_draw_char_xy(x, y, *p) + 1;
+	}
+	return x;
+}
@@ -32,6 +32,7 @@
 	SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <stddef.h>
 #include "glcd.h"
 
 #if defined(GLCD_DEVICE_AVR8)
@@ -46,6 +47,7 @@ void glcd_tiny_set_font(const char * font_table, uint8_t width, uint8_t height,
 	font_current.start_char = start_char;
 	font_current.end_char = end_char;
 	font_current.table_type = STANG;
+	font_current.charmap = NULL;
 }
 
 void glcd_tiny_draw_char(uint8_t x, uint8_t line, char c)
@@ -67,12 +69,15 @@ void glcd_tiny_draw_char(uint8_t x, uint8_t line, char c)
 	}		
 	
 	glcd_update_bbox(x, line*(font_current.height + 1), x+font_current.width, line*(font_current.height + 1) + (font_current.height + 1));
+	if (!GLCD_PAGE_VISIBLE(line)) {
+		return;
+	}
 	
 	for ( i = 0; i < font_current.width; i++ ) {
 #if defined(GLCD_DEVICE_AVR8)		
-		glcd_buffer_selected[x + (line * GLCD_LCD_WIDTH)] = pgm_read_byte( font_current.font_table + ((c - font_current.start_char) * (font_current.width)) + i );
+		GLCD_PAGE(line)[x] = pgm_read_byte( font_current.font_table + ((c - font_current.start_char) * (font_current.width)) + i );
 #else
-		glcd_buffer_selected[x + (line * GLCD_LCD_WIDTH)] = *( font_current.font_table + ((c - font_current.start_char) * (font_current.width)) + i );
+		GLCD_PAGE(line)[x] = *( font_current.font_table + ((c - font_current.start_char) * (font_current.width)) + i );
 #endif
 		x++;
 	}
@@ -125,6 +130,7 @@ void glcd_tiny_draw_string_P(uint8_t x, uint8_t line, const char *str)
 	}	
 }
 
+#if !defined(GLCD_USE_STRIP_BUFFER)
 void glcd_tiny_draw_string_ammend(char *str) {
 	glcd_scroll_line();
 	glcd_tiny_draw_string(0, (GLCD_LCD_HEIGHT/8-1), str);
@@ -136,6 +142,7 @@ void glcd_tiny_draw_string_ammend_P(const char *str) {
 	glcd_tiny_draw_string_P(0, (GLCD_LCD_HEIGHT/8-1), str);
 	glcd_write();
 }
+#endif
 
 void glcd_tiny_invert_line(uint8_t line)
 {
@@ -1,308 +1,342 @@
 #include "glcd.h"
 
 #include "visuals.h" 
+#include "widgets.h"
 #include "stdio.h"
 #include "stdlib.h"
 
-#include "fonts/Calibri23x38.h"
 #include "include/machineData.h"
+#include "include/mileageLog.h"
+#include "include/jobLog.h"
+#include "include/speedHistory.h"
 #include "fonts/battery8x8.h"
-#include "fonts/font5x7.h"
-#include "fonts/font13x14.h"
+#include "fonts/font5x7_subset.h"
+#include "fonts/font13x14_subset.h"
 
-//Our magic wand to save about !!!2KB!!! of flash memory.
-extern int mini_snprintf(char* buffer, unsigned int buffer_len, const char *fmt, ...);
+/*Calibri23x38 is only needed while one of the big readouts still uses it*/
+#if !defined(USE_SEGMENT_DIGITS_SPEED) || !defined(USE_SEGMENT_DIGITS_DISTANCE)
+#define FONT_LARGE_USED
+#include "fonts/Calibri23x38_subset.h"
+#endif
 
+/*The background generator needs the static tables to render them, and writes backgrounds.h itself*/
+#if defined(BACKGROUND_GENERATOR)
+#undef USE_PRERENDERED_BACKGROUNDS
+#define logoBackground logo
+#else
+#include "backgrounds.h"
+#endif
 
-void showLogo(const unsigned char *data) {
-	/*Show PKED logo*/
-	glcd_draw_bitmap(data); //something instead...
-	glcd_write();
-	Delay_Ms(3000);
-	/*Go to the next screen*/
-	machineData.visuals.currentScreen++;
-}
+/*
+ * Font descriptors for the screen tables, indexed by screenFont_e. The text fonts only hold the
+ * glyphs the strings in this file draw, tools/fonts regenerates them from the labels and fields.
+ * Their range is the first to the last of those characters, the charmap has an entry for each.
+ */
+const glcd_FontConfig_t screenFonts[] = {
+	[fontSmall]   = {Font5x7_subset, 5, 7, Font5x7_FIRST_CHAR, Font5x7_LAST_CHAR, STANG, Font5x7_charmap},
+	[fontMedium]  = {Trebuchet_MS13x14_subset, 13, 14, Trebuchet_MS13x14_FIRST_CHAR, Trebuchet_MS13x14_LAST_CHAR, PACKED, Trebuchet_MS13x14_charmap},
+	#if defined(FONT_LARGE_USED)
+	[fontLarge]   = {Calibri23x38_subset, 23, 38, Calibri23x38_FIRST_CHAR, Calibri23x38_LAST_CHAR, PACKED, Calibri23x38_charmap},
+	#endif
+	[fontBattery] = {battery8x8, 8, 8, 0, 6, STANG, NULL},
+};
+
+/*
+ * Seven-segment digit geometry, indexed by screenSegments_e. 40 rows starting on page 1 with
+ * 4 row thick segments keep every horizontal segment inside one page, so each one is a single
+ * masked byte per column.
+ */
+const glcd_SegmentStyle_t screenSegmentStyles[] = {
+	[segmentsSpeed]    = {20, 40, 4, 3},
+	[segmentsDistance] = {20, 40, 4, 4},
+};
 
+/*Outside temperature in the top-right corner, next to the battery symbol*/
+#if defined(USE_TEMPERATURE_HUMIDITY_SENSOR)
+#define WIDGET_OUTSIDE_TEMPERATURE WIDGET_FIELD(95, 0, 24, 8, fontSmall, 0, 0, 0, 0, "C", valueI8, machineData.machine.outsideTemperature),
+#else
+#define WIDGET_OUTSIDE_TEMPERATURE
+#endif
+/*Small battery symbol in the top-right corner*/
+#define WIDGET_BATTERY WIDGET_ICON(119, 0, fontBattery, machineData.visuals.batteryIcon)
 
 
-/**
- * @brief Display a small battery symbol in the top-right corner. Blinks when charging.
- * 
+/*
+ * Every table driven screen is a <name>Static table(labels, separators, boxes) and a
+ * <name>Fields table(everything bound to a variable). With USE_PRERENDERED_BACKGROUNDS the
+ * static tables are replaced by <name>Background images from backgrounds.h, which
+ * tools/backgrounds generates from these very tables.
  */
-static void showBatteryState (void) {
-	glcd_tiny_set_font(battery8x8,8,8,0,6);
-	if (machineData.flags.batteryCharging == true) {
-		static _Bool batteryChargingBlinkIcon;
-		static uint8_t batteryChargingBlinkIconPeriodDivider = BATTERY_CHARGING_BLINK_PERIOD_DIVIDER;
-
-		batteryChargingBlinkIconPeriodDivider--;
-		if (batteryChargingBlinkIconPeriodDivider == 0) {
-			batteryChargingBlinkIcon = !batteryChargingBlinkIcon;
-			batteryChargingBlinkIconPeriodDivider = BATTERY_CHARGING_BLINK_PERIOD_DIVIDER;
-		}
-			if (batteryChargingBlinkIcon) {
-				glcd_draw_char_xy(119, 0, machineData.machine.batteryState); //Show the current state of charge
-			}
-			else {
-				glcd_draw_char_xy(119, 0, 6); //Show no battery icon
-			}
+#define SCREEN_BOUND_COUNT(name) (sizeof(name##Fields)/sizeof(name##Fields[0]))
+/*renderScreen() caches the value of every bound widget in WIDGETS_MAX_BOUND slots*/
+#define SCREEN_BOUND_CHECK(name) \
+	_Static_assert(SCREEN_BOUND_COUNT(name) <= WIDGETS_MAX_BOUND, #name "Fields has more widgets than WIDGETS_MAX_BOUND")
+#if defined(USE_PRERENDERED_BACKGROUNDS)
+#define SCREEN_LAYOUT(name) SCREEN_BOUND_CHECK(name); static const screenLayout_t name##Layout = \
+	{NULL, name##Fields, name##Background, 0, SCREEN_BOUND_COUNT(name)}
+#else
+#define SCREEN_LAYOUT(name) SCREEN_BOUND_CHECK(name); static const screenLayout_t name##Layout = \
+	{name##Static, name##Fields, NULL, sizeof(name##Static)/sizeof(name##Static[0]), SCREEN_BOUND_COUNT(name)}
+#endif
 
-	}
-	else {
-		glcd_draw_char_xy(119, 0, machineData.machine.batteryState); //Show the current state of charge
-	}
-}
 
+/*Screen where speed readout font is the biggest one on the screen*/
+#if !defined(USE_PRERENDERED_BACKGROUNDS)
+static const widget_t mainScreenSpeedStatic[] = {
+	WIDGET_LABEL(13, 0, fontSmall, "Speed:"),
+	WIDGET_LABEL(13, 50, fontSmall, "m/min"),
+	//Separation lines
+	WIDGET_SEPARATOR(65, 0, 2, 64),
+	WIDGET_SEPARATOR(65, 33, 63, 2),
+	WIDGET_LABEL(83, 9, fontSmall, "Time:"),
+	WIDGET_LABEL(73, 38, fontSmall, "Distance:"),
+};
+#endif
+static const widget_t mainScreenSpeedFields[] = {
+	#if defined(USE_SEGMENT_DIGITS_SPEED)
+	WIDGET_SEGMENTS(17, 8, 47, 40, segmentsSpeed, 2, 0, 0, 0, valueI16, machineData.machine.speed),
+	#else
+	WIDGET_FIELD(17, 8, 47, 38, fontLarge, 2, 0, 0, 0, "", valueI16, machineData.machine.speed),
+	#endif
+	WIDGET_FIELD(76, 17, 52, 14, fontMedium, 3, 0, 0, 0, "", valueU16, machineData.machine.time),
+	WIDGET_FIELD(70, 48, 58, 14, fontMedium, 0, 0, 1, 0, "m", valueU32, machineData.machine.currentDistance),
+	WIDGET_OUTSIDE_TEMPERATURE
+	WIDGET_BATTERY,
+};
+SCREEN_LAYOUT(mainScreenSpeed);
+
+/*Screen where distance readout font is the biggest one on the screen*/
+#if !defined(USE_PRERENDERED_BACKGROUNDS)
+static const widget_t mainScreenDistanceStatic[] = {
+	WIDGET_LABEL(5, 0, fontSmall, "Distance m:"),
+	WIDGET_LABEL(75, 51, fontSmall, "Time:"),
+};
+#endif
+static const widget_t mainScreenDistanceFields[] = {
+	#if defined(USE_SEGMENT_DIGITS_DISTANCE)
+	WIDGET_SEGMENTS(0, 8, 128, 40, segmentsDistance, 6, GLCD_NUMBER_ZERO_PAD, 1, 1, valueU32, machineData.machine.currentDistance),
+	#else
+	WIDGET_FIELD(0, 9, 128, 38, fontLarge, 6, GLCD_NUMBER_ZERO_PAD, 1, 1, "", valueU32, machineData.machine.currentDistance),
+	#endif
+	WIDGET_FIELD(102, 48, 26, 14, fontMedium, 3, 0, 0, 0, "", valueU16, machineData.machine.time),
+	WIDGET_FIELD(3, 48, 70, 14, fontMedium, 0, 0, 0, 0, "m/min", valueI16, machineData.machine.speed),
+	WIDGET_OUTSIDE_TEMPERATURE
+	WIDGET_BATTERY,
+};
+SCREEN_LAYOUT(mainScreenDistance);
+
+#if defined(USE_SPEED_CHART)
+/*Speed over the last SPEED_CHART_WIDTH samples, the 1s tier of the speed history. The chart sits on whole pages, every column is 6 bytes*/
+#define SPEED_CHART_HEIGHT 48u
+static uint8_t speedChartBar(uint8_t age);
+static glcd_SweepGraph_t speedChart = {speedChartBar, SPEED_CHART_WIDTH, 0};
+
+#if !defined(USE_PRERENDERED_BACKGROUNDS)
+static const widget_t speedChartScreenStatic[] = {
+	WIDGET_LABEL(0, 0, fontSmall, "Speed:"),
+	//Full scale line right above the chart
+	WIDGET_SEPARATOR(0, 64 - SPEED_CHART_HEIGHT - 2, 128, 1),
+};
+#endif
+static const widget_t speedChartScreenFields[] = {
+	WIDGET_FIELD(36, 0, 60, 8, fontSmall, 0, 0, 0, 0, " m/min", valueI16, machineData.machine.speed),
+	WIDGET_CHART(0, 64 - SPEED_CHART_HEIGHT, SPEED_CHART_WIDTH, SPEED_CHART_HEIGHT, speedChart),
+	WIDGET_BATTERY,
+};
+SCREEN_LAYOUT(speedChartScreen);
+#endif
 
+/*Screen with all the mileage data*/
+#if !defined(USE_PRERENDERED_BACKGROUNDS)
+static const widget_t settingsScreenStatic[] = {
+	WIDGET_LABEL(0, 0, fontSmall, "Machine mileage:"),
+	WIDGET_LABEL(0, 20, fontSmall, "Service in:"),
+	WIDGET_LABEL(0, 41, fontSmall, "On time age:"),
+};
+#endif
+static const widget_t settingsScreenFields[] = {
+	WIDGET_FIELD(0, 10, 118, 8, fontSmall, 0, 0, 1, 0, " m", valueU32, mileageData.machineMileage),
+	WIDGET_FIELD(0, 30, 128, 8, fontSmall, 0, 0, 1, 0, " m", valueI32, mileageData.serviceOverdue),
+	WIDGET_FIELD(0, 50, 128, 8, fontSmall, 0, 0, 0, 0, " min", valueU16, mileageData.machineOnTimeAge),
+	WIDGET_FIELD(74, 41, 54, 8, fontSmall, 0, 0, 0, 0, "% wear", valueU8, mileageLogStats.wear), //Flash checkpoint budget used
+	WIDGET_BATTERY,
+};
+SCREEN_LAYOUT(settingsScreen);
+
+/*The same once the service is due, the service line reads "Overdue by -12 m". Picked by getScreenLayout()*/
+#if !defined(USE_PRERENDERED_BACKGROUNDS)
+static const widget_t settingsScreenOverdueStatic[] = {
+	WIDGET_LABEL(0, 0, fontSmall, "Machine mileage:"),
+	WIDGET_LABEL(0, 20, fontSmall, "Service in:"),
+	WIDGET_LABEL(0, 30, fontSmall, "Overdue by"),
+	WIDGET_LABEL(0, 41, fontSmall, "On time age:"),
+};
+#endif
+static const widget_t settingsScreenOverdueFields[] = {
+	WIDGET_FIELD(0, 10, 118, 8, fontSmall, 0, 0, 1, 0, " m", valueU32, mileageData.machineMileage),
+	WIDGET_FIELD(66, 30, 62, 8, fontSmall, 0, 0, 1, 0, " m", valueI32, mileageData.serviceOverdue),
+	WIDGET_FIELD(0, 50, 128, 8, fontSmall, 0, 0, 0, 0, " min", valueU16, mileageData.machineOnTimeAge),
+	WIDGET_FIELD(74, 41, 54, 8, fontSmall, 0, 0, 0, 0, "% wear", valueU8, mileageLogStats.wear),
+	WIDGET_BATTERY,
+};
+SCREEN_LAYOUT(settingsScreenOverdue);
+
+/*One job of the job log, UP steps back through them*/
+#if !defined(USE_PRERENDERED_BACKGROUNDS)
+static const widget_t jobHistoryScreenStatic[] = {
+	WIDGET_LABEL(0, 0, fontSmall, "Job"),
+	WIDGET_LABEL(0, 14, fontSmall, "Distance:"),
+	WIDGET_LABEL(0, 26, fontSmall, "Time:"),
+	WIDGET_LABEL(0, 38, fontSmall, "Max speed:"),
+	WIDGET_LABEL(0, 50, fontSmall, "Avg speed:"),
+};
+#endif
+static const widget_t jobHistoryScreenFields[] = {
+	WIDGET_FIELD(24, 0, 48, 8, fontSmall, 0, 0, 0, 0, "", valueU16, jobHistoryShown.sequence),
+	WIDGET_FIELD(64, 14, 64, 8, fontSmall, 0, 0, 1, 0, " m", valueU32, jobHistoryShown.distance),
+	WIDGET_FIELD(64, 26, 64, 8, fontSmall, 0, 0, 0, 0, " min", valueU16, jobHistoryShown.time),
+	WIDGET_FIELD(64, 38, 64, 8, fontSmall, 0, 0, 0, 0, " m/min", valueU8, jobHistoryShown.maxSpeed),
+	WIDGET_FIELD(64, 50, 64, 8, fontSmall, 0, 0, 0, 0, " m/min", valueU8, jobHistoryShown.avgSpeed),
+	WIDGET_BATTERY,
+};
+SCREEN_LAYOUT(jobHistoryScreen);
 
-/**
- * @brief Displays the temperature on the screen.
- * 
- * This function shows the temperature on the screen using the GLCD library.
- * It formats the temperature value as a string and then draws the string on the screen.
- * 
- * @note The temperature value is obtained from the `machineData` structure.
- * 
- * @note The temperature is displayed using the Font5x7 font with a size of 5x7 pixels.
- * 
- * @note The temperature string is limited to 8 characters, including the 'C' symbol.
- * 
- * @note The temperature string is drawn at the coordinates (95, 0) on the screen.
- */
-static void showTemperature (void) {
-	char str[16] = {0};
-	//Show the temperature on the screen
-	glcd_tiny_set_font(Font5x7,5,7,32,127);
-	mini_snprintf(str, 8, "%dC", machineData.machine.outsideTemperature);
-	glcd_draw_string_xy(95, 0, str);
+#if defined(USE_TEMPERATURE_HUMIDITY_SENSOR)
+/*Outside temperature and humidity*/
+#if !defined(USE_PRERENDERED_BACKGROUNDS)
+static const widget_t temperatureHumidityScreenStatic[] = {
+	WIDGET_LABEL(0, 15, fontSmall, "Temperature"),
+	WIDGET_LABEL(80, 15, fontSmall, "Humidity"),
+	WIDGET_BOX(3, 29, 50, 25),
+	WIDGET_BOX(80, 29, 40, 25),
+};
+#endif
+static const widget_t temperatureHumidityScreenFields[] = {
+	WIDGET_FIELD(10, 35, 42, 14, fontMedium, 0, 0, 0, 0, "*C", valueI8, machineData.machine.outsideTemperature),
+	WIDGET_FIELD(85, 35, 34, 14, fontMedium, 0, 0, 0, 0, "%", valueU8, machineData.machine.outsideHumidity),
+	WIDGET_BATTERY,
+};
+SCREEN_LAYOUT(temperatureHumidityScreen);
+#endif
+
+/*PKED logo shown after powering up, a background with nothing on top*/
+static const screenLayout_t logoScreenLayout = {NULL, NULL, logoBackground, 0, 0};
+
+/*Full screen messages*/
+static const widget_t messageScreenFields[] = {
+	WIDGET_BATTERY,
+};
+static const widget_t lowBatteryScreenStatic[] = {
+	WIDGET_LABEL(0, 30, fontSmall, "Battery low!"),
+};
+static const widget_t serviceMeScreenStatic[] = {
+	WIDGET_LABEL(0, 30, fontSmall, "Service me!"),
+};
+static const screenLayout_t lowBatteryScreenLayout = {lowBatteryScreenStatic, messageScreenFields, NULL, 1, 1};
+static const screenLayout_t serviceMeScreenLayout = {serviceMeScreenStatic, messageScreenFields, NULL, 1, 1};
+
+/*Every screen is table driven. NULL ones are not built in and get skipped*/
+static const screenLayout_t *const screenLayouts[] = {
+	[logoScreen] = &logoScreenLayout,
+	[mainScreenDistance] = &mainScreenDistanceLayout,
+	[mainScreenSpeed] = &mainScreenSpeedLayout,
+	#if defined(USE_SPEED_CHART)
+	[speedChartScreen] = &speedChartScreenLayout,
+	#endif
+	#if defined(USE_TEMPERATURE_HUMIDITY_SENSOR)
+	[temperatureHumidityScreen] = &temperatureHumidityScreenLayout,
+	#endif
+	[settingsScreen] = &settingsScreenLayout,
+	[jobHistoryScreen] = &jobHistoryScreenLayout,
+	[serviceMeScreen] = &serviceMeScreenLayout,
+	[lowBatteryScreen] = &lowBatteryScreenLayout,
+};
+
+
+
+const screenLayout_t *getScreenLayout(currentScreen_e screen) {
+	if (screen >= sizeof(screenLayouts)/sizeof(screenLayouts[0])) {
+		return NULL;
+	}
+	if (screen == settingsScreen && mileageData.serviceOverdue <= 0) {
+		return &settingsScreenOverdueLayout;
+	}
+	return screenLayouts[screen];
 }
 
 
 
+#if defined(USE_SPEED_CHART)
 /**
- * @brief Screen where speed readout font is the biggest one on the screen.
- * 
- * @param machineData Pointer to the main data chunk structure
+ * @brief Bar height of a chart column, from the 1s tier of the speed history. Anything over SPEED_CHART_FULL_SCALE
+ * is drawn full height, a column with no sample yet is empty.
  */
-static inline void showMainScreenSpeed (machineData_t* machineData) 
-{
-	char str[64] = {0};
-	//Clean the buffer
-	glcd_clear_buffer();
-
-	//Show the speed on the screen
-	glcd_tiny_set_font(Font5x7,5,7,32,127);
-	glcd_draw_string_xy_P(13, 0, "Speed:");
-
-	glcd_set_font(Calibri23x38,23,38,46,57);
-	mini_snprintf(str, 3, "%2d", (int8_t)machineData->machine.speed);
-	glcd_draw_string_xy(17, 8, str);
-
-	glcd_tiny_set_font(Font5x7,5,7,32,127);
-	glcd_draw_string_xy_P(13, 50, "m/min");
-
-	//Draw separation lines
-	glcd_draw_line(65, 0, 65, 64, 1);
-	glcd_draw_line(66, 0, 66, 64, 1);
-
-	glcd_draw_line(65, 33, 128, 33, 1);
-	glcd_draw_line(65, 34, 128, 34, 1);
-
-	//Show the time on the screen
-	glcd_tiny_set_font(Font5x7,5,7,32,127);
-	glcd_draw_string_xy_P(83, 9, "Time:");
-
-	glcd_set_font(Trebuchet_MS13x14,13,14,32,127);
-	mini_snprintf(str, 5, "%3u", machineData->machine.time);
-	glcd_draw_string_xy(76, 17, str); 
-	
-	//Show the distance on the screen
-	glcd_tiny_set_font(Font5x7,5,7,32,127);
-	glcd_draw_string_xy_P(73, 38, "Distance:");
-
-	glcd_set_font(Trebuchet_MS13x14,13,14,32,127); 
-	mini_snprintf(str, 6, "%ldm", (machineData->machine.currentDistance)/10);
-	glcd_draw_string_xy(70, 48, str);
+static uint8_t speedChartBar(uint8_t age) {
+	speedSample_t sample;
+	if (!speedHistoryGet(speedTier1s, age, &sample)) {
+		return 0;
+	}
+	uint8_t speed = (sample.avg > SPEED_CHART_FULL_SCALE) ? SPEED_CHART_FULL_SCALE : sample.avg;
+	return (uint8_t)((speed * SPEED_CHART_HEIGHT) / SPEED_CHART_FULL_SCALE);
 }
 
 
-/**
- * @brief Screen where distance readout font is the biggest one on the screen
- * 
- * @param machineData Pointer to the main data chunk structure
- */
-static inline void showMainScreenDistance (machineData_t* machineData)
-{
-	char str[64] = {0};
-
-	//Clean the buffer
-	glcd_clear_buffer();
-
-	//Show the distance on the screen
-	glcd_tiny_set_font(Font5x7,5,7,32,127);
-	glcd_draw_string_xy_P(5, 0, "Distance m:");
 
-	glcd_set_font(Calibri23x38,23,38,46,57);
-	mini_snprintf(str, 7, "%04ld.%ld", (machineData->machine.currentDistance/10), (machineData->machine.currentDistance%10));
-	glcd_draw_string_xy(0, 9, str);
-
-	//Show the time on the screen 
-	glcd_tiny_set_font(Font5x7,5,7,32,127);
-	glcd_draw_string_xy_P(75, 51, "Time:");
-
-	glcd_set_font(Trebuchet_MS13x14,13,14,32,127);
-	mini_snprintf(str, 5, "%3u", machineData->machine.time);
-	glcd_draw_string_xy(102, 48, str);
-
-	glcd_set_font(Trebuchet_MS13x14,13,14,32,127);
-	mini_snprintf(str, 8, "%dm/min", machineData->machine.speed);
-	glcd_draw_string_xy(3, 48, str);
+void advanceSpeedChart(void) {
+	glcd_sweep_graph_advance(&speedChart);
 }
+#endif
 
 
-/**
- * @brief Screen with all the mileage data.
- * 
- * @param machineData Pointer to the main data chunk structure
- */
-static inline void showSettingsScreen (machineData_t* machineData) {
-		char str[64] = {0};
-
-		//Clean the buffer
-		glcd_clear_buffer();
-
-		//Show the distance on the screen
-		glcd_tiny_set_font(Font5x7,5,7,32,127);
-		glcd_draw_string_xy_P(0, 0, "Machine mileage:");
-		mini_snprintf(str, 14, "%lu m", mileageData.machineMileage/10);
-		glcd_draw_string_xy(0, 10, str);
-
-		glcd_draw_string_xy_P(0, 20, "Service in:");
-		if (mileageData.serviceOverdue <= 0) {
-			mini_snprintf(str, 24, "Overdue by %ld m", mileageData.serviceOverdue/10);
-			glcd_draw_string_xy_P(0, 30, "");
-		}
-		else {
-			mini_snprintf(str, 20, "%ld m", mileageData.serviceOverdue/10);
-			glcd_draw_string_xy(0, 30, str);
-		}
-		glcd_draw_string_xy(0, 30, str);
-
-		//Show the machine mileage
-		glcd_draw_string_xy_P(0, 41, "On time age:");
-		mini_snprintf(str, 14, "%u min", mileageData.machineOnTimeAge);
-		glcd_draw_string_xy(0, 50, str);
-}
 
+/*Hides the battery symbol every other phase while charging. Applied by glcd_write(), the icon itself is not redrawn*/
+static const glcd_Overlay_t chargingOverlay[] = {
+	{119, 0, 8, 8, GLCD_OVERLAY_CLEAR, 0x01},
+};
 
-#if defined(USE_TEMPERATURE_HUMIDITY_SENSOR)
-/**
- * @brief Displays the temperature and humidity screen on the LCD.
- * 
- * This function clears the LCD buffer and then displays the temperature and humidity values
- * on the screen. It uses the machineData structure to retrieve the temperature and humidity
- * values and formats them into strings before displaying them on the LCD.
- * 
- * @param machineData Pointer to the machineData_t structure containing the temperature and humidity values.
- */ 
-static inline void showTemperatureHumidityScreen (machineData_t* machineData) {
-	char str[64] = {0};
-
-	//Clean the buffer
-	glcd_clear_buffer(); 
-	
-	glcd_tiny_set_font(Font5x7,5,7,32,127);
-	glcd_draw_string_xy_P(0, 15, "Temperature");
-	glcd_draw_string_xy_P(80, 15, "Humidity"); 
-
-	glcd_draw_rect(3, 29, 50, 25, 1);
-	glcd_draw_rect(80, 29, 40, 25, 1);
-
-	glcd_set_font(Trebuchet_MS13x14,13,14,32,127);
-	//Show the temperature on the screen
-	mini_snprintf(str, 8, "%d*C", machineData->machine.outsideTemperature); 
-	glcd_draw_string_xy(10, 35, str);
-
-	//Show the humidity on the screen 
-	mini_snprintf(str, 8, "%u%%", machineData->machine.outsideHumidity);
-	glcd_draw_string_xy(85, 35, str);
-}
-#endif
 
 
 /**
- * @brief Draw "Battery low!" message in the middle of the screen
+ * @brief Work out which battery symbol to show. Blinks when charging.
  * 
  */
-static inline void showLowBatteryScreen (void) {
-	glcd_tiny_set_font(Font5x7,5,7,32,127);
-	glcd_draw_string_xy_P(0, 30, "Battery low!");
-	glcd_write();
+static void updateBatteryIcon (void) {
+	machineData.visuals.batteryIcon = machineData.machine.batteryState; //Show the current state of charge
+	glcd_set_overlays(chargingOverlay, machineData.flags.batteryCharging ? 1 : 0);
+	//Blink on the clock, not on the frame count, the frame rate is not fixed
+	glcd_set_overlay_phase((sysTickCnt & BATTERY_CHARGING_BLINK_PERIOD) ? 1 : 0);
 }
 
 
 
-/**
- * @brief Draw "Service me!" message in the middle of the screen
- * 
- */
-static inline void showServiceMeScreen(void) {
-	//Show the message that machine needs to be serviced
-	glcd_tiny_set_font(Font5x7,5,7,32,127);
-	glcd_draw_string_xy_P(0, 30, "Service me!");
-	glcd_write();
-	Delay_Ms(3000);
-	glcd_clear();
-	/*Go to the next screen*/
-	machineData.visuals.currentScreen = mainScreenDistance;
-} 
+void updateScreen (machineData_t* machineData) { 
+	updateBatteryIcon();
 
+	const screenLayout_t *layout = getScreenLayout(machineData->visuals.currentScreen);
+	if (layout == NULL) {
+		//No sensor for temperatureHumidityScreen, skip the screen
+		machineData->visuals.currentScreen++;
+		return;
+	}
 
+	//Only the widgets that changed since the last frame end up in the bounding box
+	renderScreen(layout);
+	glcd_write();
 
-void updateScreen (machineData_t* machineData) { 
 	switch (machineData->visuals.currentScreen) {
-				case logoScreen:
-					showLogo(logo);
-					break;
-
-				case mainScreenSpeed:
-					showMainScreenSpeed(machineData);
-					#if defined(USE_TEMPERATURE_HUMIDITY_SENSOR)
-					showTemperature();
-					#endif
-					break;
-
-				case mainScreenDistance:
-					showMainScreenDistance(machineData);
-					#if defined(USE_TEMPERATURE_HUMIDITY_SENSOR)
-					showTemperature();
-					#endif
-					break;
-
-				case temperatureHumidityScreen:
-					#if defined(USE_TEMPERATURE_HUMIDITY_SENSOR)
-					showTemperatureHumidityScreen(machineData);
-					#else
-					machineData->visuals.currentScreen++;
-					#endif
-					break;
-
-				case settingsScreen:
-					showSettingsScreen(machineData);
-					break;
-
-				case lowBatteryScreen:
-					showLowBatteryScreen();
-					break;
-
-				case serviceMeScreen:
-					showServiceMeScreen();
-					break;
-
-				default:
-					break;
-			}
-			//Draw battery symbol according to the current battery state 
-			showBatteryState(); 
-			glcd_write();
+		case logoScreen:
+			//Show the logo for 3 seconds, then go to the next screen
+			Delay_Ms(3000);
+			machineData->visuals.currentScreen++;
+			break;
+
+		case serviceMeScreen:
+			//Show the message that machine needs to be serviced
+			Delay_Ms(3000);
+			machineData->visuals.currentScreen = mainScreenDistance;
+			break;
+
+		default:
+			break;
+	}
 }
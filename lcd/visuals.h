@@ -2,23 +2,34 @@
 
 #include "include/main.h" 
 #include "include/machineData.h"
+#include "widgets.h"
 
 //External variables
 extern uint32_t sysTickCnt;
 
-/*Bitmap pictures*/
+/*Bitmap pictures. Source art for tools/backgrounds, the firmware shows the packed logoBackground*/
 extern const unsigned char logo[];
 
 /**
- * @brief Show the logo for 3 seconds after powering up.
+ * @brief Update/load(if machineData.visuals.currentScreen doesn't match to what we are showing now.) data on the screen.
  * 
- * @param data 
+ * @param machineData Pointer to the main data chunk structure to get
  */
-extern void showLogo (const unsigned char *data); 
+extern void updateScreen (machineData_t* machineData);
 
 /**
- * @brief Update/load(if machineData.visuals.currentScreen doesn't match to what we are showing now.) data on the screen.
+ * @brief Get the widget tables of a screen. The settings screen has a second layout for an overdue service,
+ * picked by mileageData.serviceOverdue.
  * 
- * @param machineData Pointer to the main data chunk structure to get
+ * @param screen Screen to look up
+ * @return const screenLayout_t* Layout, or NULL if the screen is not built in
  */
-extern void updateScreen (machineData_t* machineData);
+extern const screenLayout_t *getScreenLayout (currentScreen_e screen);
+
+#if defined(USE_SPEED_CHART)
+/**
+ * @brief Move the speed chart on by a column, after speedHistoryAdd(). The chart reads the speed history itself,
+ * the chart screen draws the new column on its next frame.
+ */
+extern void advanceSpeedChart (void);
+#endif
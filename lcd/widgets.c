@@ -0,0 +1,235 @@
+#include "glcd.h"
+#include "widgets.h"
+
+/*Layout currently shown and the values its bound widgets were last drawn with*/
+static const screenLayout_t *activeLayout;
+static int32_t boundValueCache[WIDGETS_MAX_BOUND];
+
+
+
+static int32_t readBoundValue(const widget_t *widget) {
+	switch (widget->valueType) {
+		case valueU8:  return *(const uint8_t *)widget->value;
+		case valueI8:  return *(const int8_t *)widget->value;
+		case valueU16: return *(const uint16_t *)widget->value;
+		case valueI16: return *(const int16_t *)widget->value;
+		case valueU32: return (int32_t)*(const uint32_t *)widget->value;
+		case valueI32: return *(const int32_t *)widget->value;
+		case valueChart: return ((const glcd_SweepGraph_t *)widget->value)->head;
+		default:       return 0;
+	}
+}
+
+
+
+/**
+ * @brief Draw a single widget into the frame buffer.
+ * 
+ * @param widget Widget description
+ * @param value Current value of the bound variable(ignored for the static widgets)
+ * @param previous Value the widget shows now, or NULL if it is not on the screen yet. Only used by seven-segment fields and charts
+ */
+static void drawWidget(const widget_t *widget, int32_t value, const int32_t *previous) {
+	uint8_t x;
+
+	if (widget->type == widgetChart) {
+		//The columns from the old head up to the new one, or all of them
+		uint8_t count = widget->w;
+		if (previous != NULL) {
+			count = (value >= *previous) ? value - *previous + 1 : value + widget->w - *previous + 1;
+		}
+		glcd_sweep_graph_draw(widget->x, widget->y, widget->h, widget->value, count);
+		return;
+	}
+
+	if (widget->type == widgetSegments) {
+		if (previous == NULL) {
+			glcd_fill_rect(widget->x, widget->y, widget->w, widget->h, WHITE);
+		}
+		glcd_draw_segment_number_xy(widget->x, widget->y, value, previous, &widget->number, &screenSegmentStyles[widget->font]);
+		return;
+	}
+
+	font_current = screenFonts[widget->font];
+	switch (widget->type) {
+		case widgetLabel:
+			glcd_draw_string_xy_P(widget->x, widget->y, widget->text);
+			break;
+
+		case widgetSeparator:
+			glcd_fill_rect(widget->x, widget->y, widget->w, widget->h, BLACK);
+			break;
+
+		case widgetBox:
+			glcd_draw_rect(widget->x, widget->y, widget->w, widget->h, BLACK);
+			break;
+
+		case widgetField:
+			//Wipe the old text first, the new one may be shorter
+			glcd_fill_rect(widget->x, widget->y, widget->w, widget->h, WHITE);
+			x = glcd_draw_number_xy(widget->x, widget->y, value, &widget->number);
+			glcd_draw_string_xy_P(x, widget->y, widget->text);
+			break;
+
+		case widgetIcon:
+			glcd_draw_char_xy(widget->x, widget->y, (char)value);
+			break;
+
+		default:
+			break;
+	}
+}
+
+
+
+void renderStaticLayer(const screenLayout_t *layout) {
+	const widget_t *widget = layout->staticWidgets;
+
+	glcd_clear_buffer();
+	for (uint8_t i = 0; i < layout->staticCount; i++, widget++) {
+		drawWidget(widget, 0, NULL);
+	}
+}
+
+
+
+#if defined(GLCD_USE_STRIP_BUFFER)
+/**
+ * @brief Whether a widget can reach the page in the strip buffer. Labels and icons are as tall
+ * as their font, STANG fonts always write 8 rows.
+ */
+static _Bool isOnStripPage(const widget_t *widget) {
+	uint8_t height = widget->h;
+	if (widget->type == widgetLabel || widget->type == widgetIcon) {
+		height = screenFonts[widget->font].height;
+		if (height < 8) {
+			height = 8;
+		}
+	}
+	return (widget->y / 8 <= glcd_strip_page) && ((widget->y + height - 1) / 8 >= glcd_strip_page);
+}
+
+
+
+/**
+ * @brief Draw the whole active screen with the cached values. Replayed once per page by glcd_render_area().
+ */
+static void drawActiveLayout(void) {
+	const widget_t *widget = activeLayout->boundWidgets;
+
+	if (activeLayout->background != NULL) {
+		glcd_draw_packed_bitmap(activeLayout->background);
+	}
+	else {
+		renderStaticLayer(activeLayout);
+	}
+	for (uint8_t i = 0; i < activeLayout->boundCount; i++, widget++) {
+		if (isOnStripPage(widget)) {
+			drawWidget(widget, boundValueCache[i], NULL);
+		}
+	}
+}
+
+
+
+void renderScreen(const screenLayout_t *layout) {
+	const widget_t *widget = layout->boundWidgets;
+	int32_t *cache = boundValueCache;
+
+	//Nothing is kept between frames. Draw the changed widgets with no page visible, which only
+	//grows the bounding box, then replay the whole screen over that area page by page.
+	//The bounding box may already hold overlay areas, see glcd_set_overlay_phase()
+	glcd_strip_page = GLCD_STRIP_NONE;
+	if (layout != activeLayout) {
+		glcd_bbox_refresh();
+		activeLayout = layout;
+		for (uint8_t i = 0; i < layout->boundCount; i++) {
+			boundValueCache[i] = readBoundValue(&layout->boundWidgets[i]);
+		}
+	}
+	else {
+		for (uint8_t i = 0; i < layout->boundCount; i++, widget++, cache++) {
+			int32_t value = readBoundValue(widget);
+			if (value != *cache) {
+				drawWidget(widget, value, cache);
+				*cache = value;
+			}
+		}
+	}
+
+	glcd_BoundingBox_t area = *glcd_bbox_selected;
+	glcd_render_area(&area, drawActiveLayout);
+}
+#else
+/**
+ * @brief Bytes glcd_write() spends on a bounding box, with the 3 address commands of every page.
+ */
+static uint16_t bboxCost(const glcd_BoundingBox_t *bbox) {
+	if (bbox->x_min > bbox->x_max) {
+		return 0; //Empty
+	}
+	return (uint16_t)(bbox->x_max - bbox->x_min + 1 + 3) * (bbox->y_max / 8 - bbox->y_min / 8 + 1);
+}
+
+
+
+/**
+ * @brief Draw a widget, sending what was pending first if one box around both would cost more than two.
+ * E.g. a field at the top and a chart column at the bottom would otherwise resend most of the screen.
+ */
+static void drawWidgetFlushing(const widget_t *widget, int32_t value, const int32_t *previous) {
+	glcd_BoundingBox_t pending = *glcd_bbox_selected;
+	glcd_BoundingBox_t drawn;
+
+	glcd_reset_bbox();
+	drawWidget(widget, value, previous);
+	drawn = *glcd_bbox_selected;
+
+	*glcd_bbox_selected = pending;
+	if (drawn.x_min <= drawn.x_max) {
+		glcd_update_bbox(drawn.x_min, drawn.y_min, drawn.x_max, drawn.y_max);
+	}
+	if (bboxCost(glcd_bbox_selected) > bboxCost(&pending) + bboxCost(&drawn)) {
+		*glcd_bbox_selected = pending;
+		glcd_write();
+		*glcd_bbox_selected = drawn;
+	}
+}
+
+
+
+void renderScreen(const screenLayout_t *layout) {
+	const widget_t *widget = layout->boundWidgets;
+	int32_t *cache = boundValueCache;
+	_Bool redrawAll = (layout != activeLayout);
+
+	if (redrawAll) {
+		//New screen. Start from scratch with the static layer
+		if (layout->background != NULL) {
+			glcd_draw_packed_bitmap(layout->background);
+		}
+		else {
+			renderStaticLayer(layout);
+		}
+		activeLayout = layout;
+	}
+
+	for (uint8_t i = 0; i < layout->boundCount; i++, widget++, cache++) {
+		int32_t value = readBoundValue(widget);
+		if (redrawAll) {
+			drawWidget(widget, value, NULL);
+			*cache = value;
+		}
+		else if (value != *cache) {
+			drawWidgetFlushing(widget, value, cache);
+			*cache = value;
+		}
+	}
+}
+#endif
+
+
+
+void invalidateScreen(void) {
+	activeLayout = NULL;
+}
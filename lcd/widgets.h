@@ -0,0 +1,128 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "glcd.h"
+
+/*
+ * Retained-mode screen model.
+ *
+ * A screen is a pair of static const widget tables. Labels, separators and boxes are the
+ * static layer: it is drawn once when the screen is entered, either widget by widget or
+ * by unpacking a background image pre-rendered on the host. Fields and icons are
+ * bound to a variable; after the first frame they are only redrawn when the bound
+ * value changes, so glcd_write() only has to push the bounding box of what moved.
+ */
+
+/*Widget kinds*/
+typedef enum {
+	widgetLabel,     //Constant text
+	widgetSeparator, //Filled w x h bar
+	widgetBox,       //Rectangle outline
+	widgetField,     //Fixed-point number bound to a variable, followed by a constant suffix
+	widgetIcon,      //Single glyph, the bound variable is the glyph index
+	widgetSegments,  //Fixed-point number bound to a variable, drawn as seven-segment digits
+	widgetChart,     //glcd_SweepGraph_t, w must be its size
+} widgetType_e;
+
+/*How to read the bound variable*/
+typedef enum {
+	valueU8,
+	valueI8,
+	valueU16,
+	valueI16,
+	valueU32,
+	valueI32,
+	valueChart, //Head of a glcd_SweepGraph_t, moves with every sample
+} widgetValue_e;
+
+/*Fonts the screens can use. Index into screenFonts[]. The text fonts are subsets, see tools/fonts*/
+typedef enum {
+	fontSmall,      //Font5x7
+	fontMedium,     //Trebuchet_MS13x14
+	fontLarge,      //Calibri23x38, digits only
+	fontBattery,    //battery8x8 icons
+} screenFont_e;
+
+/*Seven-segment digit sizes the screens can use. Index into screenSegmentStyles[]*/
+typedef enum {
+	segmentsSpeed,     //Two digits next to the speed screen separator
+	segmentsDistance,  //Five digits and a point across the whole distance screen
+} screenSegments_e;
+
+typedef struct {
+	uint8_t type;       //widgetType_e
+	uint8_t x;
+	uint8_t y;
+	uint8_t w;          //Separator/box size, or the width cleared before a field/icon is redrawn
+	uint8_t h;
+	uint8_t font;       //screenFont_e, screenSegments_e for seven-segment fields
+	uint8_t valueType;  //widgetValue_e
+	glcd_NumberFormat_t number; //Field: how the value is printed
+	const char *text;   //Label text or field suffix
+	const void *value;  //Bound variable of a field or icon
+} widget_t;
+
+typedef struct {
+	const widget_t *staticWidgets; //Labels, separators, boxes. NULL when a pre-rendered background is used
+	const widget_t *boundWidgets;  //Fields and icons
+	const uint8_t *background;     //Pre-rendered static layer in glcd_draw_packed_bitmap() format, or NULL
+	uint8_t staticCount;
+	uint8_t boundCount;
+} screenLayout_t;
+
+/*Max number of fields+icons on one screen*/
+#define WIDGETS_MAX_BOUND 8u
+
+/*Table row helpers*/
+#define WIDGET_LABEL(x, y, font, text) {widgetLabel, x, y, 0, 0, font, 0, {0}, text, NULL}
+#define WIDGET_SEPARATOR(x, y, w, h) {widgetSeparator, x, y, w, h, 0, 0, {0}, NULL, NULL}
+#define WIDGET_BOX(x, y, w, h) {widgetBox, x, y, w, h, 0, 0, {0}, NULL, NULL}
+/*
+ * A field prints var with at least width characters(GLCD_NUMBER_ZERO_PAD in flags pads with '0'),
+ * taking the last scale digits as decimals and showing the first decimals of them, then suffix.
+ * E.g. 12345 with scale 1: decimals 1 gives "1234.5", decimals 0 gives "1234".
+ */
+#define WIDGET_FIELD(x, y, w, h, font, width, flags, scale, decimals, suffix, valueType, var) \
+	{widgetField, x, y, w, h, font, valueType, \
+	{width, scale, decimals, (flags) | (((valueType) == valueU32) ? GLCD_NUMBER_UNSIGNED : 0)}, suffix, &(var)}
+/*Seven-segment field, no suffix. Only the digits that change get redrawn*/
+#define WIDGET_SEGMENTS(x, y, w, h, style, width, flags, scale, decimals, valueType, var) \
+	{widgetSegments, x, y, w, h, style, valueType, \
+	{width, scale, decimals, (flags) | (((valueType) == valueU32) ? GLCD_NUMBER_UNSIGNED : 0)}, NULL, &(var)}
+/*Sweep chart, only the columns added since the last frame get redrawn*/
+#define WIDGET_CHART(x, y, w, h, graph) {widgetChart, x, y, w, h, 0, valueChart, {0}, NULL, &(graph)}
+#define WIDGET_ICON(x, y, font, var) {widgetIcon, x, y, 0, 0, font, valueU8, {0}, NULL, &(var)}
+
+/*Font descriptors, defined next to the font tables in visuals.c*/
+extern const glcd_FontConfig_t screenFonts[];
+/*Seven-segment digit geometry, defined in visuals.c*/
+extern const glcd_SegmentStyle_t screenSegmentStyles[];
+
+/**
+ * @brief Render a screen into the frame buffer.
+ *
+ * If the layout differs from the one rendered last time, the buffer is cleared and every widget is drawn.
+ * Otherwise only the fields/icons whose bound value changed are redrawn, seven-segment fields only the digits
+ * that changed and charts only the new columns. What is drawn is left in the bounding box for glcd_write(), except
+ * that widgets far apart are sent right away when one box around them would resend more than they cover.
+ * With GLCD_USE_STRIP_BUFFER there is no frame buffer to keep the screen in: the area that changed is
+ * worked out first, then the whole screen is replayed for every page in it and sent to the LCD right away.
+ *
+ * @param layout Screen description table
+ */
+void renderScreen(const screenLayout_t *layout);
+
+/**
+ * @brief Clear the frame buffer and draw only the static widgets of a screen.
+ * Used by renderScreen() and by the host-side background generator.
+ *
+ * @param layout Screen description table
+ */
+void renderStaticLayer(const screenLayout_t *layout);
+
+/**
+ * @brief Forget what is on the screen, so the next renderScreen() draws everything again.
+ * Call after something other than renderScreen() has drawn into the frame buffer.
+ */
+void invalidateScreen(void);
@@ -71,7 +71,7 @@
  * @return      FLASH Status - The returned value can be: FLASH_BUSY, FLASH_ERROR_PG,
  *             FLASH_ERROR_WRP, FLASH_COMPLETE or FLASH_TIMEOUT.
  */
-inline FLASH_Status FLASH_ProgramHalfWord(uint32_t Address, uint16_t Data)
+RAM_FUNCTION FLASH_Status FLASH_ProgramHalfWord(uint32_t Address, uint16_t Data)
 {
     FLASH_Status status = FLASH_COMPLETE;
 
@@ -79,7 +79,7 @@ inline FLASH_Status FLASH_ProgramHalfWord(uint32_t Address, uint16_t Data)
     if(status == FLASH_COMPLETE)
     {
         FLASH->CTLR |= CR_PG_Set;
-        *(__IO uint16_t *)Address = Data;
+        *(__IO uint16_t *)(uintptr_t)Address = Data;
         status = FLASH_WaitForLastOperation(ProgramTimeout);
         FLASH->CTLR &= CR_PG_Reset;
     }
@@ -96,7 +96,7 @@ inline FLASH_Status FLASH_ProgramHalfWord(uint32_t Address, uint16_t Data)
  * @return  FLASH Status - The returned value can be: FLASH_BUSY, FLASH_ERROR_PG,
  *        FLASH_ERROR_WRP or FLASH_COMPLETE.
  */
-FLASH_Status FLASH_GetBank1Status(void)
+RAM_FUNCTION FLASH_Status FLASH_GetBank1Status(void)
 {
     FLASH_Status flashstatus = FLASH_COMPLETE;
 
@@ -128,7 +128,7 @@ FLASH_Status FLASH_GetBank1Status(void)
  * @return  FLASH Status - The returned value can be: FLASH_BUSY, FLASH_ERROR_PG,
  *        FLASH_ERROR_WRP or FLASH_COMPLETE.
  */
-FLASH_Status FLASH_WaitForLastOperation(uint32_t Timeout)
+RAM_FUNCTION FLASH_Status FLASH_WaitForLastOperation(uint32_t Timeout)
 {
     FLASH_Status status = FLASH_COMPLETE;
 
@@ -149,83 +149,10 @@ volatile FLASH_Status FLASHStatus = FLASH_COMPLETE;
 
 
 
-uint16_t* findMemoryBlock(uint16_t* ptrToFlashLocation, uint16_t storageSize, uint16_t sizeOfData, bool readOrWrite);
-uint16_t* findMemoryBlock(uint16_t* ptrToFlashLocation, uint16_t storageSize, uint16_t sizeOfData, bool readOrWrite)
-{ 
-	if (readOrWrite) 
-	{
-		//Set the pointer to the last block because we want to find the LAST written block.
-		uint16_t* ptr = ptrToFlashLocation + storageSize/sizeof(*ptr)- sizeOfData/sizeof(*ptr) ; //
-		//We want to read the data. So we have to find the last written block or return NULL if all blocks are empty.
-		while (ptr > ptrToFlashLocation - sizeOfData/sizeof(*ptr))
-		{
-			uint16_t* i = ptr;
-			for (uint16_t j = 0; j < (sizeOfData/sizeof(*ptr))+0; j++)
-			{
-				if (*i != 0xFFFFu)
-				{
-					//We've found the last written block. Return the pointer to it.
-					return ptr;
-				}
-				i++;
-			}
-			//Next block
-			ptr -= sizeOfData/sizeof(*ptr);
-		}
-		//All blocks are empty. Return NULL.
-		return NULL;									
-	}
-	else //We want to write the data. So we have to find the first empty block or return NULL if all blocks are full.
-	{
-		uint16_t* ptr = ptrToFlashLocation;
-		while (ptr < (ptrToFlashLocation + storageSize/sizeof(*ptr)))
-		{
-			uint16_t* i = ptr;
-			for (uint16_t j = 0; j < sizeOfData/sizeof(*ptr); j++)
-			{
-				if (*i != 0xFFFFu)
-				{
-					//Next block 
-					goto nextBlock;
-				}
-				i++;
-			}
-			//We've found the first empty block. Return the pointer to it. 
-			return ptr;
-
-			nextBlock:
-			ptr += sizeOfData/sizeof(*ptr);
-		}
-		//All blocks are full. Return NULL.
-		return NULL;									
-	}
-}
-
-void getSavedMileageDataFromFlash(uint16_t* ptrToFlashLocation, uint32_t storageSize, uint32_t sizeOfData) {
-    uint16_t* ptr = findMemoryBlock(ptrToFlashLocation, storageSize, sizeOfData, true);
-	if (ptr == NULL)
-	{
-		//No data found. Reset the mileageData structure to zero. 
-		memset(&mileageData, 0, sizeof(mileageData));
-		mileageData.serviceOverdue = MACHINE_SERVICE_INTERVALS;
-	}
-	else
-	{
-		//Data found. Copy it to mileageData structure.
-		memcpy(&mileageData, ptr, sizeof(mileageData));
-		machineData.machine.currentDistance = mileageData.currentDistance;
-		machineData.machine.time = mileageData.currentTime;
-		if (mileageData.serviceOverdue <= MACHINE_SERVICE_WARNING_MESSAGE_SHOW_WHEN) machineData.flags.needsServicing = true;
-	}
-}
-
 /**
- * @brief If the battery is low, save data to FLASH to ensure that mileage can't be reset just by fully-discharging the battery
- * 
- * @param machineData 
+ * @brief Unlock the flash for erasing and programming. Resets the MCU if it stays locked.
  */
- void saveMachineMileageDataToFlash(uint16_t* ptrToFlashLocation, uint16_t storageSize, uint16_t sizeOfData) { 
-	
+void flashUnlock(void) {
 	// Unkock flash - be aware you need extra stuff for the bootloader.
 	FLASH->KEYR = 0x45670123; //Magic numbers from the datasheet.
 	FLASH->KEYR = 0xCDEF89AB; //Magic numbers from the datasheet.
@@ -243,49 +170,63 @@ void getSavedMileageDataFromFlash(uint16_t* ptrToFlashLocation, uint32_t storage
 		//Something is really really wrong. Reset everything 
 		NVIC_SystemReset();
 	}
-	
-	/*Use the last 512 bytes of flash memory to store the data*/
-	uint16_t* ptr = findMemoryBlock(ptrToFlashLocation, storageSize, sizeOfData, false);
+}
 
-	if (ptr == NULL) 
-	{
-		//No free space found. Erase the whole storage and try again.
-		//We erase 8 pages of 64 bytes each
-		//Erase Page
-		ptr = ptrToFlashLocation;
-		while (ptr < (ptrToFlashLocation + (storageSize))) //sizeof(*ptr)
-		{
-			FLASH->CTLR = CR_PAGE_ER;
-			FLASH->ADDR = (uint32_t)ptr;
-			FLASH->CTLR = CR_STRT_Set | CR_PAGE_ER;
-			while (FLASH->STATR & FLASH_STATR_BSY);  // Takes about 3ms.
-			FLASH->CTLR = FLASH_STATR_EOP; 
-			ptr += 32; //Go to the next page
-		}
-		ptr = ptrToFlashLocation; //Reset the pointer to the beginning of the storage
-		/*Ensure that we've actually erased the memory*/
-		uint16_t* i = ptrToFlashLocation;
-		while (i < (ptrToFlashLocation + (storageSize/sizeof(*i))))
-		{
-			if (*i != 0xFFFFu)
-			{
-				//Something is really really wrong. Reset everything
-				NVIC_SystemReset();
-			}
-			i++; 
-		}
+
+
+/**
+ * @brief Erase one FLASH_PAGE_SIZE page. The flash has to be unlocked.
+ * 
+ * @param address Start of the page
+ */
+RAM_FUNCTION void flashErasePage(uint32_t address) {
+	FLASH->CTLR = CR_PAGE_ER;
+	FLASH->ADDR = address;
+	FLASH->CTLR = CR_STRT_Set | CR_PAGE_ER;
+	while (FLASH->STATR & FLASH_STATR_BSY);  // Takes about 3ms.
+	FLASH->CTLR = FLASH_STATR_EOP; 
+}
+
+
+
+/**
+ * @brief Program a whole FLASH_PAGE_SIZE page in one go through the page buffer(CR_PAGE_PG/CR_BUF_LOAD).
+ * One programming cycle instead of one per halfword. The page has to be erased and the flash unlocked.
+ * 
+ * @param address Start of the page
+ * @param data FLASH_PAGE_SIZE bytes
+ * @return FLASH_Status FLASH_COMPLETE, or FLASH_TIMEOUT if the flash stayed busy
+ */
+RAM_FUNCTION FLASH_Status flashProgramPage(uint32_t address, const uint32_t *data) {
+	FLASH->CTLR = CR_PAGE_PG;
+	FLASH->CTLR = CR_BUF_RST | CR_PAGE_PG;
+	FLASH->ADDR = address;
+	while (FLASH->STATR & FLASH_STATR_BSY);
+
+	//The words go to the page buffer, not to the flash yet
+	for (uint8_t i = 0; i < FLASH_PAGE_SIZE / sizeof(*data); i++) {
+		((__IO uint32_t *)(uintptr_t)address)[i] = data[i];
+		FLASH->CTLR = CR_PAGE_PG | CR_BUF_LOAD;
+		while (FLASH->STATR & FLASH_STATR_BSY);
 	}
-	//Copy the values to the mileageData structure
-	mileageData.currentDistance = machineData.machine.currentDistance;
-	mileageData.currentTime = machineData.machine.time;
-	//Write the data to the flash
-	uint16_t* mileageDataPtr = (uint16_t*)&mileageData;
-	for (uint8_t i = 0; i < sizeof(mileageData)/sizeof(*ptr); i++, ptr++, mileageDataPtr++)
-	{
-		if (FLASH_ProgramHalfWord((uint32_t)ptr, *mileageDataPtr) != FLASH_COMPLETE)
-		{
-			NVIC_SystemReset();
-		} 
+
+	FLASH->CTLR = CR_PAGE_PG | CR_STRT_Set;
+	FLASH_Status status = FLASH_WaitForLastOperation(EraseTimeout); // Takes about as long as a page erase.
+	FLASH->CTLR &= ~CR_PAGE_PG;
+	return status;
+}
+
+
+
+/**
+ * @brief CRC-16/CCITT-FALSE, bit by bit. Slow but tiny, records are short.
+ */
+uint16_t crc16(uint16_t crc, const uint8_t *data, uint16_t length) {
+	while (length--) {
+		crc ^= (uint16_t)*data++ << 8;
+		for (uint8_t bit = 0; bit < 8; bit++) {
+			crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+		}
 	}
-	return;
-}
\ No newline at end of file
+	return crc;
+}
@@ -0,0 +1,123 @@
+#include "include/i2c.h"
+#include "include/main.h"
+
+
+#if defined(USE_TEMPERATURE_HUMIDITY_SENSOR) || defined(USE_EXTERNAL_FLASH)
+
+/*
+ * check for 32-bit event codes
+ */
+static uint8_t i2c_chk_evt(uint32_t event_mask)
+{
+	/* read order matters here! STAR1 before STAR2!! */
+	uint32_t status = I2C1->STAR1 | (I2C1->STAR2<<16);
+	return (status & event_mask) == event_mask;
+} 
+
+
+
+/*
+ * wait for an event, gives up on a NAK(acknowledge failure) or after TIMEOUT_MAX tries
+ */
+static bool i2c_wait_evt(uint32_t event_mask)
+{
+	int32_t timeout = TIMEOUT_MAX;
+	while(!i2c_chk_evt(event_mask))
+	{
+		if((I2C1->STAR1 & I2C_STAR1_AF) || (timeout-- == 0))
+			return ERROR;
+	}
+	return OK;
+}
+
+
+
+/*
+ * give the bus back after a NAK or a timeout: STOP, so the device lets go of SDA and BUSY clears,
+ * and clear the acknowledge failure, it would fail the next transfer too
+ */
+static bool i2c_abort(void)
+{
+	I2C1->CTLR1 &= ~I2C_CTLR1_ACK;
+	I2C1->CTLR1 |= I2C_CTLR1_STOP;
+	I2C1->STAR1 &= ~I2C_STAR1_AF;
+	return ERROR;
+}
+
+
+
+bool i2cReadOrWrite(uint8_t addr, uint8_t *data, uint8_t sz, bool rw)
+{
+	int32_t timeout;
+	
+	// wait for not busy
+	timeout = TIMEOUT_MAX;
+	while((I2C1->STAR2 & I2C_STAR2_BUSY) && (timeout--));
+	if(timeout==-1)
+		return i2c_abort();
+
+	// Set START condition
+	I2C1->CTLR1 |= I2C_CTLR1_START;
+	
+	// wait for master mode select
+	if(i2c_wait_evt(I2C_EVENT_MASTER_MODE_SELECT))
+		return i2c_abort();
+
+	if (rw == READ) //Read
+	{ 
+		// send 7-bit address + read flag
+		I2C1->DATAR = (addr<<1)+1;
+        
+        if (sz > 1) I2C1->CTLR1 |= I2C_CTLR1_ACK;
+
+		// wait for transmit condition, a NAK if nobody answers
+		if(i2c_wait_evt(I2C_EVENT_MASTER_RECEIVER_MODE_SELECTED))
+			return i2c_abort();
+        
+		// get data one byte at a time
+		while(sz--)
+		{
+			if (!sz) I2C1->CTLR1 &= ~I2C_CTLR1_ACK; //signal it's the last byte
+			timeout = TIMEOUT_MAX;
+			while(!(I2C1->STAR1 & I2C_FLAG_RXNE) && (timeout--));
+			if(timeout==-1)
+				return i2c_abort();
+				
+			*data++ = I2C1->DATAR;
+		}
+        I2C1->CTLR1 |= I2C_CTLR1_STOP;	// set STOP condition
+	}
+	else //Write
+	{ 
+		// send 7-bit address + write flag
+		I2C1->DATAR = addr<<1;
+
+		// wait for transmit condition, a NAK if nobody answers. With no data that is all, see deviceWaitReady in storageI2c.c
+		if(i2c_wait_evt(I2C_EVENT_MASTER_TRANSMITTER_MODE_SELECTED))
+			return i2c_abort();
+
+		if (sz)
+		{
+			// send data one byte at a time
+			while(sz--)
+			{
+				// wait for TX Empty
+				timeout = TIMEOUT_MAX;
+				while(!(I2C1->STAR1 & (I2C_STAR1_TXE | I2C_STAR1_AF)) && (timeout--));
+				if((timeout==-1) || (I2C1->STAR1 & I2C_STAR1_AF))
+					return i2c_abort();
+				
+				// send command
+				I2C1->DATAR = *data++;
+			}
+			// wait for tx complete
+			if(i2c_wait_evt(I2C_EVENT_MASTER_BYTE_TRANSMITTED))
+				return i2c_abort();
+		}
+
+        // set STOP condition
+        I2C1->CTLR1 |= I2C_CTLR1_STOP;
+	}
+	return OK;
+}
+#endif
@@ -47,6 +47,8 @@ inline void systick_init(void)
 }
 
 
+void EXTI7_0_IRQHandler(void); //In isr.c
+
 /**
  * @brief Does what it says on the tin. Init all the GPIO's
  * 
@@ -67,6 +69,10 @@ static inline void gpioInit (void)
 	AFIO->EXTICR |= (uint32_t)(0b11 << (HALL_INPUT_A_GPIO_NUM*2));
 	EXTI->INTENR |= 1<<HALL_INPUT_A_GPIO_NUM ; // Enable and EXT4 
 	EXTI->FTENR |= EXTI_Line4;
+	#if defined(USE_RAM_FLASH_ROUTINES)
+	//Straight to the handler in RAM, without reading its address from the vector table in flash
+	SetVTFIRQ((uint32_t)EXTI7_0_IRQHandler, EXTI7_0_IRQn, 0, ENABLE);
+	#endif
 	NVIC_EnableIRQ( EXTI7_0_IRQn );
 
 	asm volatile(
@@ -239,6 +245,22 @@ static inline void adcInit (void)
 
 
 
+/**
+ * @brief Power voltage detector interrupt on VDD falling under PVD_LEVEL(EXTI line 8, rising edge of PVDO)
+ * 
+ */
+void pvdInit(void)
+{
+	RCC->APB1PCENR |= RCC_APB1Periph_PWR;
+	PWR->CTLR = (PWR->CTLR & ~PWR_CTLR_PLS) | PVD_LEVEL | PWR_CTLR_PVDE;
+	EXTI->RTENR |= EXTI_Line8;
+	EXTI->INTENR |= EXTI_Line8;
+	EXTI->INTFR = EXTI_Line8;
+	NVIC_EnableIRQ(PVD_IRQn);
+}
+
+
+
 static inline void iwdgInit(uint16_t reload_val, uint8_t prescaler) {
 	IWDG->CTLR = 0x5555;
 	IWDG->PSCR = prescaler; 
@@ -270,5 +292,5 @@ inline void  init (void) {
 	#if defined(USE_TEMPERATURE_HUMIDITY_SENSOR) || defined(USE_EXTERNAL_FLASH)
 	i2cInit();
 	#endif
-	iwdgInit(0xfff, IWDG_Prescaler_256); // set up watchdog to about 2 s
+	iwdgInit(0xfff, IWDG_Prescaler_256); // set up watchdog to about 8.2 s(4095 counts of the 128kHz LSI / 256). Fed every main loop pass
 }
\ No newline at end of file
@@ -1,12 +1,19 @@
 #include "include/main.h"
 #include "include/machineData.h"
+#include "include/mileageLog.h"
+#include "include/jobLog.h"
 #include "include/flash.h"
 
 uint32_t cntToZeroTheSpeedDisplay = SPEED_SET_TO_ZERO_TIMEOUT;
 uint32_t cntToSleep = GO_TO_SLEEP_TIMEOUT;
 uint32_t cntToMeasureBattery = BATTERY_VOLTAGE_MEASURING_PERIOD;
 uint32_t cntToMeasureTemperatureAndHumidity = TEMPERATURE_AND_HIMIDITY_MEASURING_PERIOD;
-uint32_t cntToUpdateScreen = SCREEN_UPDATE_PERIOD;
+uint32_t cntToSampleSpeed = SPEED_SAMPLE_PERIOD;
+uint32_t cntToNextFrame = SCREEN_MIN_FRAME_INTERVAL;
+uint32_t cntToScreenKeepAlive = SCREEN_KEEP_ALIVE_PERIOD;
+
+//Ms between the last two wheel pulses, negative backwards. 0 once updateSpeed() has taken it
+static volatile int32_t pulsePeriod;
 
 
 
@@ -15,12 +22,14 @@ uint32_t cntToUpdateScreen = SCREEN_UPDATE_PERIOD;
  * @brief Interrupt service routine for the encoder.
  * 
  * This function is the interrupt service routine for encoder interrupt. 
- * The function updates the mileage data, calculates the machine speed, and resets the timeout values.
+ * The function updates the mileage data, takes the pulse period for the speed, and resets the timeout values.
+ * It runs from RAM(RAM_FUNCTION), so it keeps counting while the flash erases or programs. Nothing it calls
+ * may be in flash, which is why the speed division is left to updateSpeed().
  * 
  * @param None
  * @return None
  */
-__attribute__((interrupt("WCH-Interrupt-fast"))) void EXTI7_0_IRQHandler( void ) { 
+RAM_FUNCTION __attribute__((interrupt("WCH-Interrupt-fast"))) void EXTI7_0_IRQHandler( void ) { 
 	
 	static uint32_t prvSysTickcnt;
 	uint32_t sysTickCntDiff = sysTickCnt - prvSysTickcnt; 
@@ -38,15 +47,15 @@ __attribute__((interrupt("WCH-Interrupt-fast"))) void EXTI7_0_IRQHandler( void )
 		{
 			/*Forwards*/
 			machineData.machine.currentDistance += COUNTER_STEP; //Measuring wheel round length is 0.1m.
-			/*Calculate speed*/
-			machineData.machine.speed = (MS_IN_1_MINUTE/MEASURING_WHEEL_PULSES_PER_METER) / sysTickCntDiff;
+			/*For the speed*/
+			pulsePeriod = sysTickCntDiff;
 		}
 		else 
 		{
 			/*If more than 0*/
 			if (machineData.machine.currentDistance) machineData.machine.currentDistance -= COUNTER_STEP;
-			/*Calculate speed and add negative sign to it*/
-			machineData.machine.speed = -((MS_IN_1_MINUTE/MEASURING_WHEEL_PULSES_PER_METER) / sysTickCntDiff );
+			/*For the speed, with a negative sign*/
+			pulsePeriod = -(int32_t)sysTickCntDiff;
 		}
 
 		//Reset the timeout to prevent zeroing the speed.
@@ -62,6 +71,22 @@ __attribute__((interrupt("WCH-Interrupt-fast"))) void EXTI7_0_IRQHandler( void )
 
 
 
+/**
+ * @brief Ends the job: hands its counters to the main loop for the job log(newJobRq) and zeroes them.
+ * 
+ * @param reason jobEnd_e
+ */
+static void endJob(jobEnd_e reason) {
+    machineData.endedJob.distance = machineData.machine.currentDistance;
+    machineData.endedJob.time = machineData.machine.time;
+    machineData.endedJob.reason = reason;
+    machineData.machine.currentDistance = 0;
+    machineData.machine.time = 0;
+    machineData.requests.newJobRq = true;
+}
+
+
+
 /**
  * @brief Increments the time counter and updates related variables.
  *
@@ -70,10 +95,12 @@ __attribute__((interrupt("WCH-Interrupt-fast"))) void EXTI7_0_IRQHandler( void )
  * The time counter is incremented every minute, and when it reaches zero, the machine's
  * time is incremented and the on-time age is updated. The localSysTickCnt variable is
  * used to keep track of the remaining time until the next increment.
+ * A job that would run over the 16 bit minute counter is ended first.
  */
 static void incrementTimeCounter() {
     static uint32_t localSysTickCnt = MS_IN_1_MINUTE; 
     if (--localSysTickCnt == 0) {
+        if (machineData.machine.time == UINT16_MAX) endJob(jobEndTimeFull);
         machineData.machine.time++;
         mileageData.machineOnTimeAge++;
         localSysTickCnt = MS_IN_1_MINUTE;
@@ -82,6 +109,19 @@ static void incrementTimeCounter() {
 
 
 
+/**
+ * @brief Calculates the speed from the period of the last wheel pulse, if there was a new one.
+ */
+static void updateSpeed() {
+    int32_t period = pulsePeriod;
+    if (period == 0) return;
+    pulsePeriod = 0;
+    if (period > 0) machineData.machine.speed = (MS_IN_1_MINUTE/MEASURING_WHEEL_PULSES_PER_METER) / (uint32_t)period;
+    else machineData.machine.speed = -((MS_IN_1_MINUTE/MEASURING_WHEEL_PULSES_PER_METER) / (uint32_t)-period);
+}
+
+
+
 /**
  * @brief Zeroes the speed display if no signal is received within a certain timeout period(1024ms).
  * 
@@ -155,13 +195,16 @@ static void updateBacklightStatus() {
  * @brief Handles the functionality of the down button.
  * 
  * This function checks if the down button has been pressed or depressed and performs the corresponding actions.
- * If the button is pressed for a long duration, it resets the machine's current distance and time.
+ * If the button is pressed for a long duration, it ends the job(endJob()) once and keeps the machine's current
+ * distance and time at 0 while it is held.
  * If the button is pressed for a short duration, it changes the screen to the next one in the sequence.
+ * The job history screen starts from the last job.
  * 
  * @note This function assumes that the GPIO pin for the down button has been configured correctly.
  */
 static void handleDownButton() {
     static _Bool DOWNbeenPressed;
+    static _Bool DOWNlongPress;
     static uint32_t oldDOWNtimeStamp; //to determine the long and short press.
 	//Check DOWN button
 	if(GPIO_digitalRead(GPIOv_from_PORT_PIN(GPIO_port_C, BUTTON_DOWN_GPIO_NUM))) { //been pressed
@@ -173,6 +216,8 @@ static void handleDownButton() {
 		//Check if it was a long press
 		if ((sysTickCnt - oldDOWNtimeStamp) > LONG_PRESS_TIME) //Long press. Reset the counter
 		{
+			if (!DOWNlongPress) endJob(jobEndReset);
+			DOWNlongPress = true;
 			machineData.machine.currentDistance = 0;
 			machineData.machine.time = 0;
 		} 
@@ -186,8 +231,14 @@ static void handleDownButton() {
 			{
 				machineData.visuals.currentScreen = mainScreenDistance;
 			}
+			if (machineData.visuals.currentScreen == jobHistoryScreen)
+			{
+				machineData.visuals.jobHistoryAge = 0;
+				machineData.requests.jobHistoryRq = true;
+			}
 		}
 		DOWNbeenPressed = 0;
+		DOWNlongPress = 0;
 		cntToSleep = GO_TO_SLEEP_TIMEOUT;
 	}
 }
@@ -199,7 +250,8 @@ static void handleDownButton() {
  *
  * This function checks if the UP button has been pressed or depressed and performs the corresponding actions.
  * If the button is pressed for a long duration, it toggles the backlight on or off.
- * If the button is pressed for a short duration, it toggles the backlight on or off.
+ * If the button is pressed for a short duration, it toggles the backlight on or off. On the job history
+ * screen it steps to the job before instead, and from the oldest one back to the last.
  * The function also updates the machineData flags accordingly.
  * 
  * @note This function assumes that the GPIO pin for the UP button has been configured correctly.
@@ -231,6 +283,10 @@ static void handleUpButton() {
 					machineData.flags.backlightOffRq = false;
 				}
 			}
+		else if ((sysTickCnt - oldUPtimeStamp) > SHORT_PRESS_TIME && machineData.visuals.currentScreen == jobHistoryScreen) {//Short press. Older job
+			if (++machineData.visuals.jobHistoryAge >= jobLogCount()) machineData.visuals.jobHistoryAge = 0;
+			machineData.requests.jobHistoryRq = true;
+		}
 		else if ((sysTickCnt - oldUPtimeStamp) > SHORT_PRESS_TIME) {//Short press. Toggle the Backlight
 			/*If backlight is off already, set the ON request flag and vice-versa*/
 			if (TIM1->CH1CVR != 0)
@@ -305,14 +361,50 @@ static void handleButtonPresses() {
 
 
 
+/**
+ * @brief Checks if any of the values the screens mostly show moved since the last frame was requested.
+ * 
+ * Speed, distance, time, battery icon(with its charging blink) and the screen index are watched.
+ * Everything else, like the temperature or the mileage, is picked up by the keep-alive refresh.
+ * 
+ * @return true if a new frame would look different
+ */
+static _Bool displayedValuesChanged() {
+    static uint32_t shownDistance;
+    static uint16_t shownTime;
+    static int16_t shownSpeed;
+    static uint8_t shownBattery;
+    static uint8_t shownScreen;
+    uint8_t battery = machineData.machine.batteryState;
+    _Bool changed;
+
+    if (machineData.flags.batteryCharging) {
+        battery |= (sysTickCnt & BATTERY_CHARGING_BLINK_PERIOD) ? 0x80 : 0x40;
+    }
+    changed = shownDistance != machineData.machine.currentDistance || shownTime != machineData.machine.time ||
+              shownSpeed != machineData.machine.speed || shownBattery != battery ||
+              shownScreen != machineData.visuals.currentScreen;
+
+    shownDistance = machineData.machine.currentDistance;
+    shownTime = machineData.machine.time;
+    shownSpeed = machineData.machine.speed;
+    shownBattery = battery;
+    shownScreen = machineData.visuals.currentScreen;
+    return changed;
+}
+
+
+
 /**
  * @brief Performs periodic measurements and updates flags accordingly.
  * 
  * This function checks if it is time to measure the battery voltage, temperature and humidity,
- * and update the screen. If it is time, it sets the corresponding flags in the machineData structure.
+ * sample the speed for the chart, checkpoint the mileage and update the screen. If it is time, it sets the corresponding flags in the machineData structure.
+ * The screen is refreshed when a shown value changes, but not more often than SCREEN_MIN_FRAME_INTERVAL,
+ * and at least every SCREEN_KEEP_ALIVE_PERIOD.
  * 
  * @note This function assumes that the variables cntToMeasureBattery, cntToMeasureTemperatureAndHumidity,
- * and cntToUpdateScreen are properly initialized with the desired measuring periods.
+ * cntToNextFrame and cntToScreenKeepAlive are properly initialized with the desired measuring periods.
  */
 static void periodicMeasurements() {
     //Check if we need to measure the battery voltage
@@ -329,15 +421,56 @@ static void periodicMeasurements() {
     }
 	#endif
 
-    //Check if we need to update the screen
-    if (--cntToUpdateScreen == 0 && !machineData.flags.screenNeedsUpdating) {
+    //Check if the speed history and chart need their next sample
+    if (--cntToSampleSpeed == 0) {
+        machineData.requests.speedNeedsSample = 1;
+        cntToSampleSpeed = SPEED_SAMPLE_PERIOD;
+    }
+
+    //Check if the mileage needs a checkpoint saved
+    if (mileageLogCheckpointDue()) {
+        machineData.requests.checkpointRq = 1;
+    }
+
+    //Check if we need to update the screen. The values are only compared once the frame interval is over
+    if (cntToNextFrame) cntToNextFrame--;
+    if (cntToScreenKeepAlive) cntToScreenKeepAlive--;
+    if (cntToNextFrame == 0 && !machineData.flags.screenNeedsUpdating && machineData.visuals.displayPower != displaySleep &&
+        (displayedValuesChanged() || cntToScreenKeepAlive == 0)) {
+        _Bool idle = (machineData.visuals.displayPower == displayIdle);
         machineData.flags.screenNeedsUpdating = 1;
-        cntToUpdateScreen = SCREEN_UPDATE_PERIOD;
+        cntToNextFrame = idle ? SCREEN_IDLE_FRAME_INTERVAL : SCREEN_MIN_FRAME_INTERVAL;
+        cntToScreenKeepAlive = idle ? SCREEN_IDLE_KEEP_ALIVE_PERIOD : SCREEN_KEEP_ALIVE_PERIOD;
     }
 }
 
 
 
+/**
+ * @brief Picks the LCD power state from the time since the last wheel pulse or button press.
+ * 
+ * With the backlight off, the refresh slows down after DISPLAY_IDLE_TIMEOUT and the LCD goes to power save
+ * after DISPLAY_SLEEP_TIMEOUT. Any activity resets cntToSleep and brings back displayNormal at once.
+ * Only the state is set here, the main loop talks to the LCD.
+ */
+static void checkDisplayPower() {
+    uint32_t idleTime = GO_TO_SLEEP_TIMEOUT - cntToSleep;
+    displayPower_e state = displayNormal;
+
+    if (TIM1->CH1CVR == 0 && !machineData.flags.backlightOnRq) {
+        if (idleTime >= DISPLAY_SLEEP_TIMEOUT) state = displaySleep;
+        else if (idleTime >= DISPLAY_IDLE_TIMEOUT) state = displayIdle;
+    }
+    if (state == displayNormal) {
+        //Don't sit out an idle length interval after waking up
+        if (cntToNextFrame > SCREEN_MIN_FRAME_INTERVAL) cntToNextFrame = SCREEN_MIN_FRAME_INTERVAL;
+        if (cntToScreenKeepAlive > SCREEN_KEEP_ALIVE_PERIOD) cntToScreenKeepAlive = SCREEN_KEEP_ALIVE_PERIOD;
+    }
+    machineData.visuals.displayPower = state;
+}
+
+
+
 /**
  * @brief Checks if we want to power-off.
  * 
@@ -347,7 +480,7 @@ static void periodicMeasurements() {
  */
 static void doWeWantSleep() { 
     if (--cntToSleep == 0) {
-        saveMachineMileageDataToFlash(FLASH_ADDR_TO_STORE_BACKUP_DATA, NON_VOLATILE_FLASH_DATA_STORAGE_SIZE, sizeof(mileageData));
+        saveMachineMileageDataToFlash();
         goToSleep();
     }
 }
@@ -358,25 +491,61 @@ static void doWeWantSleep() {
  * @brief Interrupt handler for the SysTick timer.
  * 
  * This function is called when the SysTick timer interrupt occurs.
- * It performs various tasks such as incrementing the time counter,
+ * It performs various tasks such as incrementing the time counter, updating the speed,
  * checking battery charging status, updating backlight status, handling
- * button presses, and performing periodic measurements. It also updates
+ * button presses, picking the LCD power state and performing periodic measurements. It also updates
  * the SysTick counter and clears the interrupt flag.
+ * 
+ * The handler is in flash and stalls while the flash erases or programs, or comes late while a checkpoint
+ * has it masked. The compare only matches on equality, so it catches up on the ticks it missed instead of
+ * setting CMP behind CNT, which would stop the ticks until CNT wraps around.
  */
 __attribute__((interrupt("WCH-Interrupt-fast"))) void SysTick_Handler(void) { 
-    incrementTimeCounter();
-    zeroSpeedIfNoSignal();
-    checkBatteryChargingStatus();
-    updateBacklightStatus();
-    handleButtonPresses();
-    periodicMeasurements();
-    doWeWantSleep();
-    
-    /* update counter */
-	sysTickCnt++;
-	SysTick->CMP += (FUNCONF_SYSTEM_CORE_CLOCK/1000); 
 	/* clear IRQ */
 	SysTick->SR = 0; 
 
+    do {
+        incrementTimeCounter();
+        updateSpeed();
+        zeroSpeedIfNoSignal();
+        checkBatteryChargingStatus();
+        updateBacklightStatus();
+        handleButtonPresses();
+        checkDisplayPower();
+        periodicMeasurements();
+        doWeWantSleep();
+
+        /* update counter */
+        sysTickCnt++;
+        SysTick->CMP += (FUNCONF_SYSTEM_CORE_CLOCK/1000); 
+    } while ((int32_t)(SysTick->CNT - SysTick->CMP) >= 0);
+
+    mileageLogSealWarmState();
 }
 
+
+
+
+/**
+ * @brief Interrupt handler for the programmable voltage detector.
+ * 
+ * VDD has dropped under PVD_LEVEL, the battery can't keep the boost converter going any more.
+ * The backlight goes off first to make the hold-up time last. If VDD is back over the level after PVD_DEBOUNCE_TIME
+ * it was a dip, the backlight comes back and nothing else happens. Otherwise the LCD goes off too, the mileage is saved
+ * into the page kept erased for it and the power is switched off like after GO_TO_SLEEP_TIMEOUT.
+ */
+__attribute__((interrupt("WCH-Interrupt-fast"))) void PVD_IRQHandler(void) {
+    uint16_t backlight = TIM1->CH1CVR;
+    TIM1->CH1CVR = 0;
+    EXTI->INTFR = EXTI_Line8; //Cleared before the check, a new drop during it comes back here
+
+    Delay_Us(PVD_DEBOUNCE_TIME);
+    if (!(PWR->CSR & PWR_CSR_PVDO)) {
+        TIM1->CH1CVR = backlight;
+        return;
+    }
+
+    LCD_RESET_GPIO_PORT->BSHR = (1 << (16 + LCD_RESET_GPIO_NUM)); //Held in reset, the controller and its booster stop
+    saveMachineMileageDataOnBrownOut();
+    goToSleep();
+}
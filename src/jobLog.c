@@ -0,0 +1,124 @@
+#include "include/jobLog.h"
+#include "include/flash.h"
+#include "include/main.h"
+
+jobRecord_t jobHistoryShown;
+
+//Cached at boot. head is the slot written next, count the slots before it that hold a record
+static uint8_t head;
+static uint8_t count;
+static uint16_t nextSequence;
+
+//One record never straddles a page, and a record that does not fill its halfwords can't be programmed
+#if FLASH_PAGE_SIZE % 16u || JOB_LOG_STORAGE_SIZE % FLASH_PAGE_SIZE || JOB_LOG_PAGES < 2u
+#error "The job log needs whole pages, at least 2, of 16 byte slots"
+#endif
+
+
+
+static const jobRecord_t *slotAddress(uint8_t slot) {
+	return (const jobRecord_t *)FLASH_ADDR_TO_STORE_JOB_LOG + slot;
+}
+
+
+
+static bool slotErased(uint8_t slot) {
+	const uint16_t *p = (const uint16_t *)slotAddress(slot);
+	for (uint8_t i = 0; i < sizeof(jobRecord_t) / sizeof(*p); i++) {
+		if (p[i] != 0xFFFFu) return false;
+	}
+	return true;
+}
+
+
+
+static uint16_t jobCrc(const jobRecord_t *job) {
+	return crc16(0xFFFF, (const uint8_t *)job, offsetof(jobRecord_t, crc));
+}
+
+
+
+static bool jobValid(const jobRecord_t *job) {
+	return job->reserved == 0xFF && job->crc == jobCrc(job) && job->sequence != 0xFFFFu;
+}
+
+
+
+/**
+ * @brief The slot age slots before the head, wrapping around.
+ */
+static uint8_t slotBeforeHead(uint8_t age) {
+	return (head > age) ? head - age - 1 : head + JOB_LOG_SLOTS - age - 1;
+}
+
+
+
+void jobLogInit(void) {
+	//The newest record is the one with the highest sequence, the head is the slot after it
+	uint16_t newestSequence = 0;
+	bool found = false;
+	for (uint8_t slot = 0; slot < JOB_LOG_SLOTS; slot++) {
+		const jobRecord_t *job = slotAddress(slot);
+		if (jobValid(job) && (!found || (int16_t)(job->sequence - newestSequence) > 0)) {
+			head = (slot + 1 < JOB_LOG_SLOTS) ? slot + 1 : 0;
+			newestSequence = job->sequence;
+			found = true;
+		}
+	}
+	if (!found) head = 0;
+	nextSequence = newestSequence + 1;
+
+	//Back from the newest up to the first erased slot, or all the way round
+	count = 0;
+	while (found && count < JOB_LOG_SLOTS && !slotErased(slotBeforeHead(count))) {
+		count++;
+	}
+}
+
+
+
+void jobLogAppend(jobRecord_t *job) {
+	//Ended right after the last one, nothing to keep. It would only push a real job out of the ring
+	if (job->distance == 0 && job->time == 0) return;
+
+	flashUnlock();
+	for (;;) {
+		//Got to a page of old records. Erase it, it holds the oldest ones
+		if (head % JOB_LOG_SLOTS_PER_PAGE == 0 && !slotErased(head)) {
+			flashErasePage((uint32_t)(uintptr_t)slotAddress(head));
+			if (count > JOB_LOG_SLOTS - JOB_LOG_SLOTS_PER_PAGE) count = JOB_LOG_SLOTS - JOB_LOG_SLOTS_PER_PAGE;
+		}
+		if (slotErased(head)) break;
+		//What is left of a torn record. Leave it, it fails its CRC
+		head = (head + 1 < JOB_LOG_SLOTS) ? head + 1 : 0;
+		if (count < JOB_LOG_SLOTS) count++;
+	}
+
+	if (nextSequence == 0xFFFFu) nextSequence = 0; //Erased flash
+	job->sequence = nextSequence++;
+	job->reserved = 0xFF;
+	job->crc = jobCrc(job);
+	const uint16_t *data = (const uint16_t *)job;
+	uint32_t address = (uint32_t)(uintptr_t)slotAddress(head);
+	for (uint8_t i = 0; i < sizeof(*job) / sizeof(*data); i++, address += 2) {
+		if (FLASH_ProgramHalfWord(address, data[i]) != FLASH_COMPLETE) {
+			NVIC_SystemReset();
+		}
+	}
+	head = (head + 1 < JOB_LOG_SLOTS) ? head + 1 : 0;
+	if (count < JOB_LOG_SLOTS) count++;
+}
+
+
+
+uint8_t jobLogCount(void) {
+	return count;
+}
+
+
+
+bool jobLogGet(uint8_t age, jobRecord_t *job) {
+	if (age >= count) return false;
+	*job = *slotAddress(slotBeforeHead(age));
+	return jobValid(job);
+}
@@ -6,12 +6,15 @@
 #include "lcd/visuals.h"
 
 #include "include/aht20.h" 
-#include "include/flash.h"
+#include "include/mileageLog.h"
+#include "include/jobLog.h"
 #include "include/adc.h"
+#include "include/speedHistory.h"
 
 /*Struct where we keep all the variables*/
 machineData_t machineData;
 mileageData_t mileageData;
+screenStats_t screenStats;
 uint32_t sysTickCnt;
 
 
@@ -142,7 +145,10 @@ static inline void initializeSystem() {
     init();
     checkBattery(&machineData);
     machineData.machine.batteryTemperature = getTemperature();
-    getSavedMileageDataFromFlash(FLASH_ADDR_TO_STORE_BACKUP_DATA, NON_VOLATILE_FLASH_DATA_STORAGE_SIZE, sizeof(mileageData));
+    if (!restoreMileageDataFromRam()) getSavedMileageDataFromFlash();
+    pvdInit(); //Only once there is a log to save to
+    jobLogInit();
+    machineData.requests.jobHistoryRq = true;
 
     #if defined(USE_TEMPERATURE_HUMIDITY_SENSOR)
 	initializeAndReadTheSensor();
@@ -154,8 +160,68 @@ static inline void initializeSystem() {
 
 
 
+/**
+ * @brief Redraw the screen and keep the screenStats counters.
+ * 
+ * SysTick counts HCLK and is never reset, its CNT is used as a cycle counter.
+ */
+static void updateScreenAndStats(void) {
+	static uint32_t secondStart;
+	static uint32_t busyCycles;
+	static uint8_t frames;
+	uint32_t start = SysTick->CNT;
+
+	updateScreen(&machineData);
+
+	uint32_t cycles = SysTick->CNT - start;
+	screenStats.frameCycles = cycles;
+	if (cycles > screenStats.frameCyclesMax) {
+		screenStats.frameCyclesMax = cycles;
+	}
+	screenStats.frames++;
+	busyCycles += cycles;
+	frames++;
+
+	//Once a second, the only place that divides
+	uint32_t elapsed = sysTickCnt - secondStart;
+	if (elapsed >= 1000u) {
+		screenStats.framesPerSecond = frames;
+		screenStats.cpuLoad = busyCycles / (elapsed * (FUNCONF_SYSTEM_CORE_CLOCK / 100000u));
+		secondStart = sysTickCnt;
+		busyCycles = 0;
+		frames = 0;
+	}
+}
+
+
+
+/**
+ * @brief Put the LCD in or out of power save to follow machineData.visuals.displayPower.
+ * 
+ * Waking up resends the frame buffer, no reset or init sequence. Idle needs nothing from the LCD,
+ * the ISR just asks for fewer frames.
+ */
+static void updateDisplayPower(void) {
+	static displayPower_e applied = displayNormal;
+	displayPower_e wanted = machineData.visuals.displayPower;
+
+	if (wanted == applied) return;
+	if (wanted == displaySleep) {
+		glcd_power_down();
+	} else if (applied == displaySleep) {
+		glcd_power_up();
+		//Whatever changed while asleep, and with the strip buffer the whole screen
+		machineData.flags.screenNeedsUpdating = true;
+	}
+	applied = wanted;
+}
+
+
+
 void mainLoop() {
     while (1) {
+		//Every pass, not only with a frame: displayIdle draws one every SCREEN_IDLE_KEEP_ALIVE_PERIOD, displaySleep none at all
+		iwdgFeed();
 
         if (machineData.flags.batteryNeedsMeasuring)
 		{
@@ -177,10 +243,73 @@ void mainLoop() {
 		}
 		#endif
 
+		if (machineData.requests.newJobRq)
+		{
+			//Log the job with its speed statistics before they start over. Flash is busy, so like a checkpoint
+			//with the SysTick and PVD saves held off. Then the zeroed counters get a checkpoint of their own,
+			//a power cut can't bring the logged job back
+			jobRecord_t job = {0};
+			speedSample_t speed;
+			speedHistoryGetJobStats(&speed);
+			job.distance = machineData.endedJob.distance;
+			job.time = machineData.endedJob.time;
+			job.endOnTime = mileageData.machineOnTimeAge;
+			job.maxSpeed = speed.max;
+			job.avgSpeed = speed.avg;
+			job.reason = machineData.endedJob.reason;
+			NVIC_DisableIRQ(SysTicK_IRQn);
+			NVIC_DisableIRQ(PVD_IRQn);
+			jobLogAppend(&job);
+			machineData.requests.newJobRq = false;
+			NVIC_EnableIRQ(PVD_IRQn);
+			NVIC_EnableIRQ(SysTicK_IRQn);
+			speedHistoryResetJob();
+			machineData.visuals.jobHistoryAge = 0;
+			machineData.requests.jobHistoryRq = true;
+			machineData.requests.checkpointRq = true;
+		}
+
+		if (machineData.requests.jobHistoryRq)
+		{
+			if (!jobLogGet(machineData.visuals.jobHistoryAge, &jobHistoryShown)) {
+				memset(&jobHistoryShown, 0, sizeof(jobHistoryShown));
+			}
+			machineData.requests.jobHistoryRq = false;
+			if (machineData.visuals.currentScreen == jobHistoryScreen && machineData.visuals.displayPower != displaySleep) {
+				machineData.flags.screenNeedsUpdating = true;
+			}
+		}
+
+		if (machineData.requests.speedNeedsSample)
+		{
+			speedHistoryAdd(machineData.machine.speed);
+			#if defined(USE_SPEED_CHART)
+			advanceSpeedChart();
+			//The new column is not one of the watched values, ask for the frame here
+			if (machineData.visuals.currentScreen == speedChartScreen && machineData.visuals.displayPower != displaySleep) {
+				machineData.flags.screenNeedsUpdating = true;
+			}
+			#endif
+			machineData.requests.speedNeedsSample = false;
+		}
+
+		if (machineData.requests.checkpointRq)
+		{
+			//The power-off and brown-out saves in the SysTick and PVD interrupts can't run into this one. The wheel
+			//pulses carry on, the save takes its copy of mileageData with the encoder interrupt masked. SysTick catches up after
+			NVIC_DisableIRQ(SysTicK_IRQn);
+			NVIC_DisableIRQ(PVD_IRQn);
+			saveMachineMileageDataToFlash();
+			machineData.requests.checkpointRq = false;
+			NVIC_EnableIRQ(PVD_IRQn);
+			NVIC_EnableIRQ(SysTicK_IRQn);
+		}
+
+		updateDisplayPower();
+
 		if (machineData.flags.screenNeedsUpdating) 
 		{
-			iwdgFeed(); //Feed the watchdog
-			updateScreen(&machineData);
+			updateScreenAndStats();
 			machineData.flags.screenNeedsUpdating = false;
 		}
 
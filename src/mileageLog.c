@@ -0,0 +1,157 @@
+#include "include/mileageLog.h"
+#include "include/storage.h"
+#include "include/main.h"
+
+mileageLogStats_t mileageLogStats;
+
+//What the last save or boot left in the storage, for mileageLogCheckpointDue()
+static uint32_t savedMileage;
+static uint16_t savedOnTime;
+
+#define WARM_STATE_MAGIC 0x4D524157u //"WARM"
+
+/*Everything a warm restart needs, sealed with a CRC. In .noinit, the reset code leaves it alone*/
+typedef struct {
+	uint32_t magic;           //WARM_STATE_MAGIC
+	mileageData_t mileage;
+	storageState_t storage;   //The write head
+	uint32_t currentDistance; //The job counters from machineData
+	uint32_t savedMileage;
+	uint16_t time;
+	uint16_t savedOnTime;
+	uint16_t crc;             //CRC-16/CCITT-FALSE of everything above
+} warmState_t;
+static warmState_t warmState __attribute__((section(".noinit")));
+
+
+
+static void setSaved(const mileageData_t *data) {
+	savedMileage = data->machineMileage;
+	savedOnTime = data->machineOnTimeAge;
+}
+
+
+
+/**
+ * @brief The mileage to save. The encoder interrupt keeps running during the save, it is masked only while
+ * the fields are copied, so the mileage, the service counter and the distance all come from the same wheel pulse.
+ */
+static void takeMileageData(mileageData_t *data) {
+	NVIC_DisableIRQ(EXTI7_0_IRQn);
+	mileageData.currentDistance = machineData.machine.currentDistance;
+	mileageData.currentTime = machineData.machine.time;
+	*data = mileageData;
+	NVIC_EnableIRQ(EXTI7_0_IRQn);
+}
+
+
+
+void getSavedMileageDataFromFlash(void) {
+	if (!storageReadLatest(&mileageData)) {
+		//No data found. Reset the mileageData structure to zero and start the storage over
+		memset(&mileageData, 0, sizeof(mileageData));
+		mileageData.serviceOverdue = MACHINE_SERVICE_INTERVALS;
+		storageErase();
+		setSaved(&mileageData);
+		return;
+	}
+
+	setSaved(&mileageData);
+	machineData.machine.currentDistance = mileageData.currentDistance;
+	machineData.machine.time = mileageData.currentTime;
+	if (mileageData.serviceOverdue <= MACHINE_SERVICE_WARNING_MESSAGE_SHOW_WHEN) machineData.flags.needsServicing = true;
+}
+
+
+
+/**
+ * @brief If the battery is low, save data to FLASH to ensure that mileage can't be reset just by fully-discharging the battery
+ */
+void saveMachineMileageDataToFlash(void) {
+	uint32_t start = SysTick->CNT;
+	mileageData_t data;
+	takeMileageData(&data);
+	storageAppend(&data);
+	setSaved(&data);
+
+	mileageLogStats.saves++;
+	mileageLogStats.saveCycles = SysTick->CNT - start;
+	if (mileageLogStats.saveCycles > mileageLogStats.saveCyclesMax) mileageLogStats.saveCyclesMax = mileageLogStats.saveCycles;
+}
+
+
+
+bool mileageLogCheckpointDue(void) {
+	//Mileage is in 0.1m. With unlimited endurance the limits are 0, any change is due
+	uint32_t distance = mileageData.machineMileage - savedMileage;
+	uint16_t time = mileageData.machineOnTimeAge - savedOnTime;
+	#if defined(STORAGE_UNLIMITED_ENDURANCE)
+	return distance || time;
+	#else
+	return distance >= CHECKPOINT_DISTANCE * 10u || time >= CHECKPOINT_TIME;
+	#endif
+}
+
+
+
+void saveMachineMileageDataOnBrownOut(void) {
+	uint32_t start = SysTick->CNT;
+	mileageData_t data;
+	takeMileageData(&data);
+	storageAppendUrgent(&data);
+	setSaved(&data);
+
+	mileageLogStats.brownOutSaves++;
+	mileageLogStats.brownOutCycles = SysTick->CNT - start;
+}
+
+
+
+/**
+ * @brief The state as it is now, padding zeroed so it can be compared and CRCed byte by byte.
+ */
+static void getWarmState(warmState_t *state) {
+	memset(state, 0, sizeof(*state));
+	state->magic = WARM_STATE_MAGIC;
+	state->mileage = mileageData;
+	storageGetState(&state->storage);
+	state->currentDistance = machineData.machine.currentDistance;
+	state->savedMileage = savedMileage;
+	state->time = machineData.machine.time;
+	state->savedOnTime = savedOnTime;
+}
+
+
+
+void mileageLogSealWarmState(void) {
+	warmState_t state;
+	getWarmState(&state);
+	//The CRC only when something changed: a wheel pulse, a minute or a save
+	if (memcmp(&state, &warmState, offsetof(warmState_t, crc)) == 0) return;
+	state.crc = crc16(0xFFFF, (const uint8_t *)&state, offsetof(warmState_t, crc));
+	warmState = state;
+}
+
+
+
+bool restoreMileageDataFromRam(void) {
+	uint32_t resetFlags = RCC->RSTSCKR;
+	RCC->RSTSCKR |= RCC_RMVF;
+
+	//Power up, the RAM has been off. A low-power reset(LPWRRSTF, standby entered with the reset option) keeps the RAM,
+	//the copy is taken like after any other warm reset
+	if (resetFlags & RCC_PORRSTF) return false;
+	if (warmState.magic != WARM_STATE_MAGIC ||
+		warmState.crc != crc16(0xFFFF, (const uint8_t *)&warmState, offsetof(warmState_t, crc))) {
+		return false;
+	}
+
+	mileageData = warmState.mileage;
+	storageSetState(&warmState.storage);
+	savedMileage = warmState.savedMileage;
+	savedOnTime = warmState.savedOnTime;
+	machineData.machine.currentDistance = warmState.currentDistance;
+	machineData.machine.time = warmState.time;
+	if (mileageData.serviceOverdue <= MACHINE_SERVICE_WARNING_MESSAGE_SHOW_WHEN) machineData.flags.needsServicing = true;
+	return true;
+}
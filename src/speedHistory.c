@@ -0,0 +1,147 @@
+#include "include/speedHistory.h"
+
+/*1s samples per 10s slot and 10s slots per 1min slot*/
+#define SAMPLES_PER_10S_SLOT 10u
+#define SLOTS_PER_1MIN_SLOT 6u
+
+/*A slot being filled from the tier below. The sum is of the 1s samples, so every tier averages the raw data*/
+typedef struct {
+	uint16_t sum;
+	uint8_t min;
+	uint8_t max;
+	uint8_t count; //Samples or slots of the tier below taken in
+} speedAccumulator_t;
+
+static struct {
+	uint8_t samples1s[SPEED_HISTORY_1S_SLOTS];
+	speedSample_t slots10s[SPEED_HISTORY_10S_SLOTS];
+	speedSample_t slots1min[SPEED_HISTORY_1MIN_SLOTS];
+	uint8_t head[SPEED_HISTORY_TIERS];  //Slot written next
+	uint8_t count[SPEED_HISTORY_TIERS]; //Slots holding data
+	speedAccumulator_t next10s;
+	speedAccumulator_t next1min;
+	uint32_t jobSum;
+	uint32_t jobSamples;
+	uint8_t jobMin;
+	uint8_t jobMax;
+} speedHistory;
+
+_Static_assert(sizeof(speedHistory) <= SPEED_HISTORY_RAM_BUDGET, "Speed history over SPEED_HISTORY_RAM_BUDGET, shorten a tier");
+
+static const uint8_t tierSize[SPEED_HISTORY_TIERS] = {SPEED_HISTORY_1S_SLOTS, SPEED_HISTORY_10S_SLOTS, SPEED_HISTORY_1MIN_SLOTS};
+
+
+
+/**
+ * @brief Take the next slot of a tier's ring buffer, overwriting the oldest one when full.
+ *
+ * @return uint8_t Index of the slot to write
+ */
+static uint8_t nextSlot(speedTier_e tier) {
+	uint8_t slot = speedHistory.head[tier];
+
+	if (++speedHistory.head[tier] == tierSize[tier]) {
+		speedHistory.head[tier] = 0;
+	}
+	if (speedHistory.count[tier] < tierSize[tier]) {
+		speedHistory.count[tier]++;
+	}
+	return slot;
+}
+
+
+
+/**
+ * @brief Fold min/max/sum of a finer slot into the slot being built.
+ */
+static void accumulate(speedAccumulator_t *acc, uint8_t min, uint8_t max, uint16_t sum) {
+	if (acc->count == 0 || min < acc->min) {
+		acc->min = min;
+	}
+	if (acc->count == 0 || max > acc->max) {
+		acc->max = max;
+	}
+	acc->sum += sum;
+	acc->count++;
+}
+
+
+
+void speedHistoryAdd(int16_t speed) {
+	uint8_t sample = (speed < 0) ? 0 : (speed > 255) ? 255 : (uint8_t)speed;
+
+	speedHistory.samples1s[nextSlot(speedTier1s)] = sample;
+
+	//Job statistics
+	if (speedHistory.jobSamples == 0 || sample < speedHistory.jobMin) {
+		speedHistory.jobMin = sample;
+	}
+	if (sample > speedHistory.jobMax) {
+		speedHistory.jobMax = sample;
+	}
+	speedHistory.jobSum += sample;
+	speedHistory.jobSamples++;
+
+	//Cascade into the coarser tiers. The only divisions, once per 10s and per minute, by constants
+	accumulate(&speedHistory.next10s, sample, sample, sample);
+	if (speedHistory.next10s.count < SAMPLES_PER_10S_SLOT) {
+		return;
+	}
+	speedSample_t *slot = &speedHistory.slots10s[nextSlot(speedTier10s)];
+	slot->min = speedHistory.next10s.min;
+	slot->max = speedHistory.next10s.max;
+	slot->avg = (speedHistory.next10s.sum + SAMPLES_PER_10S_SLOT / 2) / SAMPLES_PER_10S_SLOT;
+	accumulate(&speedHistory.next1min, slot->min, slot->max, speedHistory.next10s.sum);
+	speedHistory.next10s = (speedAccumulator_t){0};
+
+	if (speedHistory.next1min.count < SLOTS_PER_1MIN_SLOT) {
+		return;
+	}
+	slot = &speedHistory.slots1min[nextSlot(speedTier1min)];
+	slot->min = speedHistory.next1min.min;
+	slot->max = speedHistory.next1min.max;
+	slot->avg = (speedHistory.next1min.sum + SAMPLES_PER_10S_SLOT * SLOTS_PER_1MIN_SLOT / 2) / (SAMPLES_PER_10S_SLOT * SLOTS_PER_1MIN_SLOT);
+	speedHistory.next1min = (speedAccumulator_t){0};
+}
+
+
+
+bool speedHistoryGet(speedTier_e tier, uint8_t age, speedSample_t *sample) {
+	if (tier >= SPEED_HISTORY_TIERS || age >= speedHistory.count[tier]) {
+		return false;
+	}
+	//Newest is right before the head
+	uint8_t slot = speedHistory.head[tier];
+	slot = (slot > age) ? slot - age - 1 : slot + tierSize[tier] - age - 1;
+
+	switch (tier) {
+		case speedTier1s:
+			sample->min = sample->max = sample->avg = speedHistory.samples1s[slot];
+			break;
+		case speedTier10s:
+			*sample = speedHistory.slots10s[slot];
+			break;
+		default:
+			*sample = speedHistory.slots1min[slot];
+			break;
+	}
+	return true;
+}
+
+
+
+void speedHistoryResetJob(void) {
+	speedHistory.jobSum = 0;
+	speedHistory.jobSamples = 0;
+	speedHistory.jobMin = 0;
+	speedHistory.jobMax = 0;
+}
+
+
+
+uint32_t speedHistoryGetJobStats(speedSample_t *stats) {
+	stats->min = speedHistory.jobMin;
+	stats->max = speedHistory.jobMax;
+	stats->avg = speedHistory.jobSamples ? (speedHistory.jobSum + speedHistory.jobSamples / 2) / speedHistory.jobSamples : 0;
+	return speedHistory.jobSamples;
+}
@@ -0,0 +1,339 @@
+#include "include/storage.h"
+#include "include/mileageLog.h"
+#include "include/flash.h"
+#include "include/main.h"
+
+
+#if !defined(USE_EXTERNAL_FLASH)
+
+#define SNAPSHOT_SIZE (sizeof(mileageRecordHeader_t) + sizeof(mileageData_t))
+#define LOG_SIZE (MILEAGE_LOG_PAGES * FLASH_PAGE_SIZE)
+#define DELTA_HEADER_SIZE 3u //Body length and the CRC-16 of length and body
+#define DELTA_MAX_BODY 21u   //Five varints: 5 + 5 + 5 + 3 + 3 bytes at the longest
+#define PAGE_END(offset) (((offset) / FLASH_PAGE_SIZE + 1) * FLASH_PAGE_SIZE)
+
+//Cached at boot, so a save never has to look for room. The write head is a byte offset into the area,
+//snapshot is the one the deltas of the head's page are taken against
+static uint16_t writeOffset;
+static uint16_t nextSequence;
+static mileageData_t snapshot;
+
+//The sequence goes one up per page opened, so it doubles as the erase count. It must not wrap within the budget
+#if FLASH_ENDURANCE_CYCLES * MILEAGE_LOG_PAGES > 0xFFFFu
+#error "The mileage log sequence wraps before the pages wear out, fewer pages or a wider sequence"
+#endif
+
+
+
+static uint16_t recordCrc(const mileageRecordHeader_t *header, const void *payload) {
+	uint16_t crc = crc16(0xFFFF, (const uint8_t *)&header->sequence, sizeof(header->sequence) + sizeof(header->length));
+	return crc16(crc, payload, header->length);
+}
+
+
+
+static const uint8_t *areaAddress(uint16_t offset) {
+	return (const uint8_t *)FLASH_ADDR_TO_STORE_BACKUP_DATA + offset;
+}
+
+
+
+static bool erased(uint16_t offset, uint8_t length) {
+	const uint16_t *p = (const uint16_t *)areaAddress(offset);
+	for (uint8_t i = 0; i < length / sizeof(*p); i++) {
+		if (p[i] != 0xFFFFu) return false;
+	}
+	return true;
+}
+
+
+
+static bool snapshotValid(const mileageRecordHeader_t *header) {
+	return header->magic == MILEAGE_RECORD_MAGIC && header->length == sizeof(mileageData_t) &&
+		header->crc == recordCrc(header, header + 1);
+}
+
+
+
+/*Varints: 7 bits a byte, low ones first, the top bit set on all but the last byte*/
+static uint8_t putVarint(uint8_t *p, uint32_t value) {
+	uint8_t length = 0;
+	while (value >= 0x80) {
+		p[length++] = (uint8_t)value | 0x80;
+		value >>= 7;
+	}
+	p[length++] = (uint8_t)value;
+	return length;
+}
+
+
+
+static const uint8_t *getVarint(const uint8_t *p, const uint8_t *end, uint32_t *value) {
+	uint32_t result = 0;
+	for (uint8_t shift = 0; p < end && shift < 32; shift += 7) {
+		uint8_t byte = *p++;
+		result |= (uint32_t)(byte & 0x7F) << shift;
+		if (!(byte & 0x80)) {
+			*value = result;
+			return p;
+		}
+	}
+	return NULL;
+}
+
+
+
+/*Small negative numbers to small varints: 0, -1, 1, -2, ... become 0, 1, 2, 3, ...*/
+static uint32_t zigzag(int32_t value) {
+	return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+
+
+static int32_t unzigzag(uint32_t value) {
+	return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+
+
+/**
+ * @brief Delta body of the current mileage against the page's snapshot. Five varints. Every wheel pulse moves the
+ * mileage and the service counter together, and every minute the job time and the on-time age, so the second of
+ * each pair is stored as what it did apart from the first. That is mostly 0, one byte.
+ *
+ * @return uint8_t Body length
+ */
+static uint8_t encodeDelta(uint8_t *body, const mileageData_t *data) {
+	uint32_t mileage = data->machineMileage - snapshot.machineMileage;
+	uint16_t onTime = data->machineOnTimeAge - snapshot.machineOnTimeAge;
+
+	uint8_t length = putVarint(body, mileage);
+	length += putVarint(body + length, zigzag((int32_t)(data->currentDistance - snapshot.currentDistance - mileage)));
+	length += putVarint(body + length, zigzag((int32_t)((uint32_t)data->serviceOverdue - (uint32_t)snapshot.serviceOverdue + mileage)));
+	length += putVarint(body + length, onTime);
+	length += putVarint(body + length, zigzag((int16_t)(data->currentTime - snapshot.currentTime - onTime)));
+	return length;
+}
+
+
+
+/**
+ * @brief Rebuild the mileage a delta body was made from.
+ *
+ * @return true if the body holds exactly five varints
+ */
+static bool decodeDelta(const uint8_t *body, uint8_t length, mileageData_t *data) {
+	const uint8_t *end = body + length;
+	uint32_t field[5];
+	for (uint8_t i = 0; i < 5; i++) {
+		body = body ? getVarint(body, end, &field[i]) : NULL;
+	}
+	if (body != end) return false;
+
+	data->machineMileage = snapshot.machineMileage + field[0];
+	data->currentDistance = snapshot.currentDistance + field[0] + (uint32_t)unzigzag(field[1]);
+	data->serviceOverdue = (int32_t)((uint32_t)snapshot.serviceOverdue - field[0] + (uint32_t)unzigzag(field[2]));
+	data->machineOnTimeAge = snapshot.machineOnTimeAge + field[3];
+	data->currentTime = snapshot.currentTime + field[3] + unzigzag(field[4]);
+	return true;
+}
+
+
+
+/**
+ * @brief Erase cycles used up in %. The sequence started at 0 with the first page ever written.
+ */
+static void updateWear(void) {
+	mileageLogStats.wear = (uint32_t)nextSequence * 100u / (FLASH_ENDURANCE_CYCLES * MILEAGE_LOG_PAGES);
+}
+
+
+
+/*Header and body, padded with 0xFF to whole halfwords*/
+static uint8_t deltaSize(uint8_t bodyLength) {
+	return (DELTA_HEADER_SIZE + bodyLength + 1) & ~1u;
+}
+
+
+
+static uint16_t deltaCrc(const uint8_t *delta) {
+	uint16_t crc = crc16(0xFFFF, delta, 1);
+	return crc16(crc, delta + DELTA_HEADER_SIZE, delta[0]);
+}
+
+
+
+/**
+ * @brief The page the next snapshot opens: the one after the write head's, or the head's own if it is at a page start.
+ */
+static uint16_t nextPage(void) {
+	uint16_t page = (writeOffset % FLASH_PAGE_SIZE) ? PAGE_END(writeOffset) : writeOffset;
+	return (page < LOG_SIZE) ? page : 0;
+}
+
+
+
+/**
+ * @brief Keep the next page erased, so a brown-out save is a single page programming cycle. It holds the oldest
+ * records, erase just this one. The other pages keep theirs, so a power cut from here on still leaves the last
+ * good snapshot and its deltas. Every page is still erased once per lap of the ring.
+ */
+static void eraseNextPage(void) {
+	uint16_t page = nextPage();
+	if (!erased(page, FLASH_PAGE_SIZE)) flashErasePage((uint32_t)(uintptr_t)areaAddress(page));
+}
+
+
+
+bool storageReadLatest(mileageData_t *data) {
+	//The page opened last is the one with the newest snapshot
+	uint16_t newestPage = 0;
+	uint16_t newestSequence = 0;
+	bool found = false;
+	for (uint16_t page = 0; page < LOG_SIZE; page += FLASH_PAGE_SIZE) {
+		const mileageRecordHeader_t *header = (const mileageRecordHeader_t *)areaAddress(page);
+		if (snapshotValid(header) && (!found || (int16_t)(header->sequence - newestSequence) > 0)) {
+			newestPage = page;
+			newestSequence = header->sequence;
+			found = true;
+		}
+	}
+	if (!found) return false;
+
+	memcpy(&snapshot, areaAddress(newestPage) + sizeof(mileageRecordHeader_t), sizeof(snapshot));
+	*data = snapshot;
+	nextSequence = newestSequence + 1;
+
+	//Replay the deltas. Each one stands on its own against the snapshot, the last good one wins.
+	//The first erased halfword is the write head. A torn delta ends the page, the next save opens the next one
+	uint16_t offset = newestPage + SNAPSHOT_SIZE;
+	uint16_t end = PAGE_END(newestPage);
+	writeOffset = end;
+	while (offset + DELTA_HEADER_SIZE <= end) {
+		const uint8_t *delta = areaAddress(offset);
+		if (erased(offset, DELTA_HEADER_SIZE)) {
+			writeOffset = offset;
+			break;
+		}
+		mileageData_t replayed;
+		if (delta[0] > DELTA_MAX_BODY || offset + deltaSize(delta[0]) > end || (delta[1] | (uint16_t)delta[2] << 8) != deltaCrc(delta) ||
+			!decodeDelta(delta + DELTA_HEADER_SIZE, delta[0], &replayed)) {
+			break;
+		}
+		*data = replayed;
+		offset += deltaSize(delta[0]);
+	}
+
+	updateWear();
+	flashUnlock();
+	eraseNextPage();
+	return true;
+}
+
+
+
+/**
+ * @brief Erase the pages that are not, the first save opens page 0. The wear count starts over, it is kept in the records.
+ */
+void storageErase(void) {
+	flashUnlock();
+	for (uint16_t page = 0; page < LOG_SIZE; page += FLASH_PAGE_SIZE) {
+		if (!erased(page, FLASH_PAGE_SIZE)) flashErasePage((uint32_t)(uintptr_t)areaAddress(page));
+	}
+	writeOffset = 0;
+	nextSequence = 0;
+	updateWear();
+}
+
+
+
+/**
+ * @brief Open the next page with a full snapshot.
+ */
+static void writeSnapshot(const mileageData_t *data) {
+	uint16_t page = nextPage();
+	uint32_t address = (uint32_t)(uintptr_t)areaAddress(page);
+	if (!erased(page, FLASH_PAGE_SIZE)) flashErasePage(address);
+	if (!erased(page, FLASH_PAGE_SIZE)) {
+		//Something is really really wrong. Reset everything
+		NVIC_SystemReset();
+	}
+
+	mileageRecordHeader_t header = {MILEAGE_RECORD_MAGIC, nextSequence, sizeof(*data), 0};
+	header.crc = recordCrc(&header, data);
+
+	//The page is blank, the whole snapshot goes out in one page programming cycle
+	uint32_t buffer[FLASH_PAGE_SIZE / sizeof(uint32_t)];
+	memset(buffer, 0xFF, sizeof(buffer));
+	memcpy(buffer, &header, sizeof(header));
+	memcpy((uint8_t *)buffer + sizeof(header), data, sizeof(*data));
+	if (flashProgramPage(address, buffer) != FLASH_COMPLETE) {
+		NVIC_SystemReset();
+	}
+
+	snapshot = *data;
+	nextSequence++;
+	writeOffset = page + SNAPSHOT_SIZE;
+	mileageLogStats.pageWrites++;
+	updateWear();
+}
+
+
+
+void storageAppend(const mileageData_t *data) {
+	flashUnlock();
+
+	//A delta against the snapshot if it fits in what is left of the page, else a new page
+	uint8_t delta[DELTA_HEADER_SIZE + DELTA_MAX_BODY + 1];
+	uint8_t size = 0;
+	if (writeOffset % FLASH_PAGE_SIZE) {
+		delta[0] = encodeDelta(delta + DELTA_HEADER_SIZE, data);
+		uint16_t crc = deltaCrc(delta);
+		delta[1] = (uint8_t)crc;
+		delta[2] = crc >> 8;
+		size = deltaSize(delta[0]);
+		if (DELTA_HEADER_SIZE + delta[0] < size) delta[size - 1] = 0xFF; //Padding
+		if (writeOffset + size > PAGE_END(writeOffset) || !erased(writeOffset, size)) size = 0;
+	}
+
+	if (size) {
+		//Length and CRC first, so a torn delta is never mistaken for erased space
+		uint32_t address = (uint32_t)(uintptr_t)areaAddress(writeOffset);
+		for (uint8_t i = 0; i < size; i += 2, address += 2) {
+			if (FLASH_ProgramHalfWord(address, delta[i] | (uint16_t)delta[i + 1] << 8) != FLASH_COMPLETE) {
+				NVIC_SystemReset();
+			}
+		}
+		writeOffset += size;
+	} else {
+		writeSnapshot(data);
+	}
+	eraseNextPage();
+}
+
+
+
+void storageAppendUrgent(const mileageData_t *data) {
+	flashUnlock();
+	//The next page is erased already, unless the last save was cut short. Then it is erased here, and may not make it
+	writeSnapshot(data);
+}
+
+
+
+void storageGetState(storageState_t *state) {
+	state->snapshot = snapshot;
+	state->writeOffset = writeOffset;
+	state->nextSequence = nextSequence;
+}
+
+
+
+void storageSetState(const storageState_t *state) {
+	snapshot = state->snapshot;
+	writeOffset = state->writeOffset;
+	nextSequence = state->nextSequence;
+	updateWear();
+}
+
+#endif
@@ -0,0 +1,193 @@
+#include "include/storage.h"
+#include "include/mileageLog.h"
+#include "include/i2c.h"
+#include "include/main.h"
+
+
+#if defined(USE_EXTERNAL_FLASH)
+
+/*One slot. Sequence 0xFFFFFFFF is never written, that is a blank EEPROM*/
+typedef struct {
+	uint32_t sequence; //One up every save
+	mileageData_t data;
+	uint16_t crc;      //CRC-16/CCITT-FALSE of sequence and data
+} externalRecord_t;
+
+_Static_assert(sizeof(externalRecord_t) <= EXTERNAL_STORAGE_PAGE_SIZE, "A record has to fit in one EXTERNAL_STORAGE_PAGE_SIZE slot");
+
+#if EXTERNAL_STORAGE_SLOTS < 2u || EXTERNAL_STORAGE_SLOTS > 255u
+#error "The ring needs 2 to 255 slots, a torn record must leave the one before it"
+#endif
+
+//Cached at boot, so a save never has to look for room
+static uint8_t head;
+static uint32_t nextSequence;
+
+
+
+/**
+ * @brief Memory address bytes of a slot. With one address byte, the parts up to 2KB, the bits above it go into the
+ * device address as the block number.
+ *
+ * @return uint8_t Device address
+ */
+static uint8_t deviceAddress(uint16_t address, uint8_t *command) {
+	#if EXTERNAL_STORAGE_ADDRESS_BYTES == 1
+	command[0] = (uint8_t)address;
+	return EXTERNAL_STORAGE_I2C_ADDR | ((address >> 8) & 0x07);
+	#else
+	command[0] = address >> 8;
+	command[1] = (uint8_t)address;
+	return EXTERNAL_STORAGE_I2C_ADDR;
+	#endif
+}
+
+
+
+/**
+ * @brief Random read: the memory address as a write, then the data as a read from there.
+ *
+ * @return Returns OK on success, ERROR if the device did not answer.
+ */
+static bool deviceRead(uint16_t address, void *data, uint8_t length) {
+	uint8_t command[EXTERNAL_STORAGE_ADDRESS_BYTES];
+	uint8_t device = deviceAddress(address, command);
+	if (i2cReadOrWrite(device, command, sizeof(command), WRITE)) return ERROR;
+	return i2cReadOrWrite(device, data, length, READ);
+}
+
+
+
+/**
+ * @brief ACK polling. An EEPROM does not answer its address while it programs a page, ask until it does, for
+ * EXTERNAL_STORAGE_WRITE_TIME at least. Usually done well before that, and at once if the last write is long done.
+ */
+static void deviceWaitReady(uint8_t device) {
+	#if !defined(EXTERNAL_STORAGE_FRAM)
+	for (uint8_t poll = 0; poll < EXTERNAL_STORAGE_WRITE_TIME * 10u; poll++) {
+		if (i2cReadOrWrite(device, NULL, 0, WRITE) == OK) return;
+		Delay_Us(100);
+	}
+	#else
+	(void)device;
+	#endif
+}
+
+
+
+/**
+ * @brief Page write, the memory address and the data in one transfer. An EEPROM programs the page after that and
+ * does not answer meanwhile, so the wait is for the write before this one: a save does not sit out its own write
+ * cycle, the brown-out one least of all. Reads are at boot only, before any write.
+ *
+ * @return Returns OK on success, ERROR if the device did not answer.
+ */
+static bool deviceWrite(uint16_t address, const void *data, uint8_t length) {
+	uint8_t buffer[EXTERNAL_STORAGE_ADDRESS_BYTES + EXTERNAL_STORAGE_PAGE_SIZE];
+	uint8_t device = deviceAddress(address, buffer);
+	memcpy(buffer + EXTERNAL_STORAGE_ADDRESS_BYTES, data, length);
+	deviceWaitReady(device);
+	return i2cReadOrWrite(device, buffer, EXTERNAL_STORAGE_ADDRESS_BYTES + length, WRITE);
+}
+
+
+
+static uint16_t slotAddress(uint8_t slot) {
+	return (uint16_t)slot * EXTERNAL_STORAGE_PAGE_SIZE;
+}
+
+
+
+static uint16_t recordCrc(const externalRecord_t *record) {
+	return crc16(0xFFFF, (const uint8_t *)record, offsetof(externalRecord_t, crc));
+}
+
+
+
+/**
+ * @brief Write cycles used up in %, every slot takes one per lap of the ring. An FRAM stays at 0.
+ */
+static void updateWear(void) {
+	#if !defined(STORAGE_UNLIMITED_ENDURANCE)
+	mileageLogStats.wear = nextSequence / (STORAGE_SAVES_BUDGET / 100u);
+	#endif
+}
+
+
+
+bool storageReadLatest(mileageData_t *data) {
+	//The newest record is the one with the highest sequence, the head is the slot after it
+	uint32_t newestSequence = 0;
+	bool found = false;
+	for (uint8_t slot = 0; slot < EXTERNAL_STORAGE_SLOTS; slot++) {
+		externalRecord_t record;
+		//No answer, the rest of the slots would each wait out the timeouts for nothing
+		if (deviceRead(slotAddress(slot), &record, sizeof(record)) != OK) break;
+		if (record.sequence == 0xFFFFFFFFu || record.crc != recordCrc(&record)) continue;
+		if (!found || (int32_t)(record.sequence - newestSequence) > 0) {
+			*data = record.data;
+			head = (slot + 1u < EXTERNAL_STORAGE_SLOTS) ? slot + 1 : 0;
+			newestSequence = record.sequence;
+			found = true;
+		}
+	}
+	nextSequence = newestSequence + 1;
+	updateWear();
+	return found;
+}
+
+
+
+/**
+ * @brief Blank every slot, the first save goes to slot 0. Stops at the first write the device does not take.
+ */
+void storageErase(void) {
+	uint8_t blank[sizeof(externalRecord_t)];
+	memset(blank, 0xFF, sizeof(blank));
+	for (uint8_t slot = 0; slot < EXTERNAL_STORAGE_SLOTS; slot++) {
+		if (deviceWrite(slotAddress(slot), blank, sizeof(blank)) != OK) break;
+	}
+	head = 0;
+	nextSequence = 0;
+	updateWear();
+}
+
+
+
+void storageAppend(const mileageData_t *data) {
+	externalRecord_t record;
+	memset(&record, 0xFF, sizeof(record));
+	if (nextSequence == 0xFFFFFFFFu) nextSequence = 0; //Blank EEPROM
+	record.sequence = nextSequence++;
+	record.data = *data;
+	record.crc = recordCrc(&record);
+
+	//Over the oldest record. If it does not make it, the slot fails its CRC and the newest one is still there
+	deviceWrite(slotAddress(head), &record, sizeof(record));
+	head = (head + 1u < EXTERNAL_STORAGE_SLOTS) ? head + 1 : 0;
+	updateWear();
+}
+
+
+
+void storageAppendUrgent(const mileageData_t *data) {
+	//A record is a single page write anyway, nothing to get ready beforehand
+	storageAppend(data);
+}
+
+
+
+void storageGetState(storageState_t *state) {
+	state->nextSequence = nextSequence;
+	state->head = head;
+}
+
+
+
+void storageSetState(const storageState_t *state) {
+	nextSequence = state->nextSequence;
+	head = state->head;
+	updateWear();
+}
+
+#endif
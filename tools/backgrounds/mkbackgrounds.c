@@ -0,0 +1,181 @@
+/*
+ * Host-side generator for lcd/backgrounds.h.
+ *
+ * Packs the power-up logo and renders the static layer(labels, separators, boxes) of every
+ * table driven screen with the very same lcd/ code the firmware uses. Both are packed for
+ * glcd_draw_packed_bitmap() and printed as C arrays to stdout. A size/cost report goes to stderr.
+ *
+ * Build and run through mkbackgrounds.sh.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "include/main.h"
+#include "include/machineData.h"
+#include "include/mileageLog.h"
+#include "include/jobLog.h"
+#include "lcd/glcd.h"
+#include "lcd/visuals.h"
+
+#if defined(GLCD_USE_STRIP_BUFFER)
+#error "Needs the whole frame buffer, build without GLCD_USE_STRIP_BUFFER"
+#endif
+
+#define FRAME_SIZE (GLCD_LCD_WIDTH * GLCD_LCD_HEIGHT / 8)
+#define TIMING_LOOPS 20000u
+/*sizeof(widget_t) on RV32: 7 x uint8_t, 4 byte glcd_NumberFormat_t + padding, 2 pointers*/
+#define TARGET_WIDGET_SIZE 20u
+
+/*Things the firmware provides and the lcd/ code links against*/
+machineData_t machineData;
+mileageData_t mileageData;
+mileageLogStats_t mileageLogStats;
+jobRecord_t jobHistoryShown;
+uint32_t sysTickCnt;
+void glcd_write(void) { glcd_reset_bbox(); }
+void DelaySysTick(uint32_t n) { (void)n; }
+
+/*Count the pixels the static layer costs(linked with -Wl,--wrap=glcd_set_pixel)*/
+static unsigned long setPixelCalls;
+void __real_glcd_set_pixel(uint8_t x, uint8_t y, uint8_t color);
+void __wrap_glcd_set_pixel(uint8_t x, uint8_t y, uint8_t color) {
+	setPixelCalls++;
+	__real_glcd_set_pixel(x, y, color);
+}
+
+static const struct {
+	currentScreen_e screen;
+	const char *name;
+	int32_t serviceOverdue; //Picks the layout variant of the settings screen, see getScreenLayout()
+} screens[] = {
+	{mainScreenDistance, "mainScreenDistance", 1},
+	{mainScreenSpeed, "mainScreenSpeed", 1},
+	{speedChartScreen, "speedChartScreen", 1},
+	{temperatureHumidityScreen, "temperatureHumidityScreen", 1},
+	{settingsScreen, "settingsScreen", 1},
+	{settingsScreen, "settingsScreenOverdue", 0},
+	{jobHistoryScreen, "jobHistoryScreen", 1},
+};
+
+
+
+/**
+ * @brief Pack a frame in glcd_draw_packed_bitmap() format.
+ * 
+ * @return size_t Packed size in bytes
+ */
+static size_t packFrame(const uint8_t *src, uint8_t *dst) {
+	size_t i = 0, out = 0;
+
+	while (i < FRAME_SIZE) {
+		size_t run = 1;
+		while (i + run < FRAME_SIZE && run < 129 && src[i + run] == src[i]) run++;
+
+		if (run >= 2) {
+			dst[out++] = 0x80 | (run - 2);
+			dst[out++] = src[i];
+			i += run;
+			continue;
+		}
+
+		//Literal chunk. Stop in front of any repeat of 3+ bytes, it packs better as a run
+		size_t start = i, len = 0;
+		while (i < FRAME_SIZE && len < 128) {
+			if (i + 2 < FRAME_SIZE && src[i] == src[i + 1] && src[i] == src[i + 2]) break;
+			i++;
+			len++;
+		}
+		dst[out++] = len - 1;
+		memcpy(&dst[out], &src[start], len);
+		out += len;
+	}
+	return out;
+}
+
+
+
+static size_t staticTableBytes(const screenLayout_t *layout) {
+	size_t bytes = layout->staticCount * TARGET_WIDGET_SIZE;
+	for (uint8_t i = 0; i < layout->staticCount; i++) {
+		if (layout->staticWidgets[i].text != NULL) bytes += strlen(layout->staticWidgets[i].text) + 1;
+	}
+	return bytes;
+}
+
+
+
+static double secondsPerCall(const screenLayout_t *layout, const uint8_t *packed) {
+	clock_t start = clock();
+	for (unsigned i = 0; i < TIMING_LOOPS; i++) {
+		if (packed) glcd_draw_packed_bitmap(packed);
+		else renderStaticLayer(layout);
+	}
+	return (double)(clock() - start) / CLOCKS_PER_SEC / TIMING_LOOPS;
+}
+
+
+
+int main(void) {
+	static uint8_t frame[FRAME_SIZE];
+	static uint8_t packed[2 * FRAME_SIZE];
+	size_t totalPacked = 0, totalTables = 0;
+
+	glcd_select_screen(glcd_buffer, &glcd_bbox);
+
+	printf("/*\n * Packed power-up logo and pre-rendered static layers of the table driven screens, see glcd_draw_packed_bitmap().\n");
+	printf(" * Generated by tools/backgrounds/mkbackgrounds.sh from the tables in lcd/visuals.c. Do not edit.\n */\n");
+	printf("#pragma once\n\n#include <stdint.h>\n");
+
+	//Power-up logo, always used
+	size_t logoSize = packFrame(logo, packed);
+	glcd_draw_packed_bitmap(packed);
+	if (memcmp(logo, glcd_buffer, FRAME_SIZE) != 0) {
+		fprintf(stderr, "logo: packed image does not unpack to the same frame\n");
+		return 1;
+	}
+	fprintf(stderr, "logo: %u -> %zu bytes\n", FRAME_SIZE, logoSize);
+	printf("\n/*logo: %u -> %zu bytes*/\n", FRAME_SIZE, logoSize);
+	printf("static const uint8_t logoBackground[] = {");
+	for (size_t i = 0; i < logoSize; i++) {
+		printf("%s0x%02X,", (i % 16) ? " " : "\n\t", packed[i]);
+	}
+	printf("\n};\n");
+
+	//Screen backgrounds, only with USE_PRERENDERED_BACKGROUNDS
+	printf("\n#if defined(USE_PRERENDERED_BACKGROUNDS)\n");
+
+	fprintf(stderr, "%-26s %7s %7s %10s %12s\n", "screen", "packed", "tables", "setPixels", "draw/unpack");
+	for (size_t s = 0; s < sizeof(screens)/sizeof(screens[0]); s++) {
+		mileageData.serviceOverdue = screens[s].serviceOverdue;
+		const screenLayout_t *layout = getScreenLayout(screens[s].screen);
+		if (layout == NULL || layout->staticWidgets == NULL) continue;
+
+		setPixelCalls = 0;
+		renderStaticLayer(layout);
+		memcpy(frame, glcd_buffer, FRAME_SIZE);
+		unsigned long pixels = setPixelCalls;
+
+		size_t size = packFrame(frame, packed);
+		glcd_draw_packed_bitmap(packed);
+		if (memcmp(frame, glcd_buffer, FRAME_SIZE) != 0) {
+			fprintf(stderr, "%s: packed image does not unpack to the same frame\n", screens[s].name);
+			return 1;
+		}
+
+		double ratio = secondsPerCall(layout, NULL) / secondsPerCall(layout, packed);
+		fprintf(stderr, "%-26s %7zu %7zu %10lu %11.1fx\n", screens[s].name, size, staticTableBytes(layout), pixels, ratio);
+		totalPacked += size;
+		totalTables += staticTableBytes(layout);
+
+		printf("\n/*%s: %u -> %zu bytes*/\n", screens[s].name, FRAME_SIZE, size);
+		printf("static const uint8_t %sBackground[] = {", screens[s].name);
+		for (size_t i = 0; i < size; i++) {
+			printf("%s0x%02X,", (i % 16) ? " " : "\n\t", packed[i]);
+		}
+		printf("\n};\n");
+	}
+	printf("\n#endif\n");
+	fprintf(stderr, "total: %zu bytes of images replace %zu bytes of static tables and strings\n", totalPacked, totalTables);
+	return 0;
+}
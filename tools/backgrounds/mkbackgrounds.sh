@@ -0,0 +1,20 @@
+#!/bin/bash
+
+# Regenerate lcd/backgrounds.h. Run after changing a static widget table in lcd/visuals.c.
+# Always with the full frame buffer, whatever the firmware build uses.
+cd "$(dirname "$0")/../.."
+
+gcc -O2 -UGLCD_USE_STRIP_BUFFER -DBACKGROUND_GENERATOR -I. -Ilcd -Wl,--wrap=glcd_set_pixel -o tools/backgrounds/mkbackgrounds \
+	tools/backgrounds/mkbackgrounds.c src/speedHistory.c lcd/visuals.c lcd/widgets.c lcd/graphics.c lcd/graphs.c lcd/segments.c lcd/overlay.c lcd/text.c lcd/text_tiny.c lcd/glcd.c lcd/pkedLogo.c \
+	|| exit 1
+
+#Into a temporary file first, a failed run leaves the header as it was
+if tools/backgrounds/mkbackgrounds > lcd/backgrounds.h.new; then
+	mv lcd/backgrounds.h.new lcd/backgrounds.h
+	status=0
+else
+	rm -f lcd/backgrounds.h.new
+	status=1
+fi
+rm -f tools/backgrounds/mkbackgrounds
+exit $status
@@ -0,0 +1,375 @@
+/*
+ * Host-side font subsetting compiler for the screen fonts.
+ *
+ * Usage: mkfonts <font name> <source files...>. Scans the sources for the labels and field suffixes
+ * handed to WIDGET_LABEL, WIDGET_FIELD and glcd_draw_string_*, works out which
+ * characters the font's screenFont_e slot has to draw, and prints a C header with only those
+ * glyphs plus the charmap from character to glyph number(see glcd_FontConfig_t.charmap) to stdout.
+ * MIKRO fonts are converted to the PACKED format on the way(see font_table_type_t in lcd/glcd.h),
+ * STANG fonts keep their format. Every glyph is checked to render pixel-exact against the
+ * original, and a size/speed report goes to stderr.
+ *
+ * Build and run through mkfonts.sh.
+ */
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "lcd/glcd.h"
+#include "lcd/fonts/Calibri23x38.h"
+#include "lcd/fonts/font13x14.h"
+#include "lcd/fonts/font5x7.h"
+
+#if defined(GLCD_USE_STRIP_BUFFER)
+#error "Needs the whole frame buffer, build without GLCD_USE_STRIP_BUFFER"
+#endif
+
+#define FRAME_SIZE (GLCD_LCD_WIDTH * GLCD_LCD_HEIGHT / 8)
+#define TIMING_LOOPS 200u
+#define MAX_TOKEN 256u
+
+void glcd_write(void) { glcd_reset_bbox(); }
+
+static const struct {
+	const char *name;
+	const char *header;
+	const char *screenFont;  //screenFont_e slot the font is used through
+	const char *table;
+	font_table_type_t type;
+	uint8_t width;
+	uint8_t height;
+	char start_char;
+	char end_char;
+} fonts[] = {
+	{"Font5x7", "font5x7.h", "fontSmall", Font5x7, STANG, 5, 7, 32, 127},
+	{"Trebuchet_MS13x14", "font13x14.h", "fontMedium", Trebuchet_MS13x14, MIKRO, 13, 14, 32, 127},
+	{"Calibri23x38", "Calibri23x38.h", "fontLarge", Calibri23x38, MIKRO, 23, 38, 46, 57},
+};
+
+typedef enum {
+	tokenEnd,
+	tokenIdent,
+	tokenString,
+	tokenPunct,
+} token_e;
+
+
+
+/**
+ * @brief Minimal C lexer: skips whitespace, comments and character constants,
+ * decodes string literals.
+ *
+ * @return token_e Kind of the token stored in tok
+ */
+static token_e nextToken(const char **src, char *tok) {
+	const char *p = *src;
+	token_e type;
+
+	for (;;) {
+		while (isspace((unsigned char)*p)) p++;
+		if (p[0] == '/' && p[1] == '/') {
+			while (*p && *p != '\n') p++;
+		} else if (p[0] == '/' && p[1] == '*') {
+			p = strstr(p + 2, "*/");
+			p = p ? p + 2 : "";
+		} else if (*p == '\'') {
+			for (p++; *p && *p != '\''; p++) {
+				if (*p == '\\' && p[1]) p++;
+			}
+			if (*p) p++;
+		} else {
+			break;
+		}
+	}
+
+	size_t len = 0;
+	if (*p == 0) {
+		type = tokenEnd;
+	} else if (isalnum((unsigned char)*p) || *p == '_') {
+		while ((isalnum((unsigned char)*p) || *p == '_') && len < MAX_TOKEN - 1) tok[len++] = *p++;
+		type = tokenIdent;
+	} else if (*p == '"') {
+		for (p++; *p && *p != '"' && len < MAX_TOKEN - 1; p++) {
+			char c = *p;
+			if (c == '\\' && p[1]) {
+				p++;
+				switch (*p) {
+					case 'n': c = '\n'; break;
+					case 't': c = '\t'; break;
+					case '0': c = 0; break;
+					case 'x': c = (char)strtol(p + 1, (char **)&p, 16); p--; break;
+					default: c = *p; break;
+				}
+			}
+			tok[len++] = c;
+		}
+		if (*p) p++;
+		type = tokenString;
+	} else {
+		tok[len++] = *p++;
+		type = tokenPunct;
+	}
+	tok[len] = 0;
+	*src = p;
+	return type;
+}
+
+
+
+static int isFontId(const char *tok) {
+	return strncmp(tok, "font", 4) == 0 && isupper((unsigned char)tok[4]);
+}
+
+
+
+/**
+ * @brief Mark the characters a field can print: its number(digits, sign, decimal point and
+ * space padding, see glcd_draw_number_xy()) and its suffix.
+ */
+static void addFieldChars(const char *suffix, uint8_t *used) {
+	for (const char *c = "0123456789-. "; *c; c++) used[(uint8_t)*c] = 1;
+	for (const char *c = suffix; *c; c++) used[(uint8_t)*c] = 1;
+}
+
+
+
+/**
+ * @brief Collect the characters drawn with screenFont from one source file.
+ * The font of a call is the screenFont_e named in its arguments, or else the last one named before it.
+ */
+static int scanSource(const char *path, const char *screenFont, uint8_t *used) {
+	FILE *f = fopen(path, "r");
+	if (f == NULL) {
+		perror(path);
+		return 1;
+	}
+	static char source[1 << 18];
+	size_t size = fread(source, 1, sizeof(source) - 1, f);
+	fclose(f);
+	source[size] = 0;
+
+	const char *p = source;
+	char tok[MAX_TOKEN];
+	char currentFont[MAX_TOKEN] = "";
+	token_e type;
+
+	while ((type = nextToken(&p, tok)) != tokenEnd) {
+		if (type != tokenIdent) continue;
+		if (isFontId(tok)) {
+			strcpy(currentFont, tok);
+			continue;
+		}
+
+		int isField = strcmp(tok, "WIDGET_FIELD") == 0;
+		if (!isField && strcmp(tok, "WIDGET_LABEL") != 0 && strncmp(tok, "glcd_draw_string", 16) != 0) continue;
+		const char *call = p;
+		if (nextToken(&p, tok) != tokenPunct || tok[0] != '(') {
+			p = call; //Not a call, e.g. a declaration
+			continue;
+		}
+
+		char text[MAX_TOKEN] = "";
+		char callFont[MAX_TOKEN] = "";
+		int literals = 0;
+		for (int depth = 1; depth > 0 && (type = nextToken(&p, tok)) != tokenEnd; ) {
+			if (type == tokenPunct && tok[0] == '(') depth++;
+			else if (type == tokenPunct && tok[0] == ')') depth--;
+			else if (type == tokenString && strlen(text) + strlen(tok) < MAX_TOKEN) strcat(text, tok), literals++;
+			else if (type == tokenIdent && isFontId(tok)) strcpy(callFont, tok);
+		}
+
+		if (strcmp(callFont[0] ? callFont : currentFont, screenFont) != 0) continue;
+		if (isField) {
+			addFieldChars(text, used);
+		} else if (literals == 0) {
+			fprintf(stderr, "warning: %s: text that is not a string literal is drawn with %s\n", path, screenFont);
+		} else {
+			for (const char *c = text; *c; c++) used[(uint8_t)*c] = 1;
+		}
+	}
+	return 0;
+}
+
+
+
+static uint8_t mikroPixel(const uint8_t *glyph, uint8_t bytesHigh, uint8_t col, uint8_t row) {
+	return (glyph[1 + col*bytesHigh + row/8] >> (row % 8)) & 1;
+}
+
+
+
+/**
+ * @brief Convert one MIKRO glyph to a PACKED glyph record.
+ *
+ * @return size_t Record size in bytes
+ */
+static size_t packGlyph(const uint8_t *glyph, uint8_t height, uint8_t bytesHigh, uint8_t *out) {
+	uint8_t varWidth = glyph[0];
+	int x0 = 255, x1 = -1, y0 = 255, y1 = -1;
+
+	for (int col = 0; col < varWidth; col++) {
+		for (int row = 0; row < height; row++) {
+			if (mikroPixel(glyph, bytesHigh, col, row)) {
+				if (col < x0) x0 = col;
+				if (col > x1) x1 = col;
+				if (row < y0) y0 = row;
+				if (row > y1) y1 = row;
+			}
+		}
+	}
+
+	out[0] = varWidth;
+	if (x1 < 0) {
+		//Blank glyph, nothing but the advance
+		out[1] = out[2] = out[3] = out[4] = 0;
+		return 5;
+	}
+	out[1] = x0;
+	out[2] = x1 - x0 + 1;
+	out[3] = y0;
+	out[4] = y1 - y0 + 1;
+
+	size_t len = 5;
+	uint8_t packedHigh = (out[4] + 7) / 8;
+	for (int col = x0; col <= x1; col++) {
+		for (int b = 0; b < packedHigh; b++) {
+			uint8_t dat = 0;
+			for (int bit = 0; bit < 8; bit++) {
+				int row = y0 + b*8 + bit;
+				if (row <= y1 && mikroPixel(glyph, bytesHigh, col, row)) dat |= 1 << bit;
+			}
+			out[len++] = dat;
+		}
+	}
+	return len;
+}
+
+
+
+static double secondsPerString(const glcd_FontConfig_t *font, const char *charset) {
+	size_t count = strlen(charset);
+	char str[8];
+	clock_t start = clock();
+	for (unsigned n = 0; n < TIMING_LOOPS; n++) {
+		for (size_t c = 0; c < count; c += 4) {
+			for (size_t i = 0; i < 4; i++) str[i] = charset[(c + i) % count];
+			str[4] = 0;
+			font_current = *font;
+			glcd_draw_string_xy(n % 16, (n / 16) % (GLCD_LCD_HEIGHT - font->height), str);
+		}
+	}
+	return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+
+
+int main(int argc, char **argv) {
+	static uint8_t subset[16384];
+	static uint8_t expected[FRAME_SIZE];
+	static char charset[256];
+	static uint8_t charmap[256];
+	uint8_t used[256] = {0};
+	size_t f;
+
+	for (f = 0; f < sizeof(fonts)/sizeof(fonts[0]); f++) {
+		if (argc >= 3 && strcmp(argv[1], fonts[f].name) == 0) break;
+	}
+	if (f == sizeof(fonts)/sizeof(fonts[0])) {
+		fprintf(stderr, "usage: %s <font name> <source files...>\n", argv[0]);
+		return 1;
+	}
+	for (int a = 2; a < argc; a++) {
+		if (scanSource(argv[a], fonts[f].screenFont, used)) return 1;
+	}
+	//Stands in for the characters the font does not have
+	used['.'] = 1;
+
+	uint8_t first = fonts[f].start_char, last = fonts[f].end_char;
+	uint8_t bytesHigh = (fonts[f].height + 7) / 8;
+	size_t glyphBytes = (fonts[f].type == STANG) ? fonts[f].width : 1 + fonts[f].width * bytesHigh;
+	size_t rawSize = (last - first + 1) * glyphBytes;
+	size_t glyphs = 0;
+
+	for (unsigned c = 0; c < 256; c++) {
+		if (!used[c]) continue;
+		if (c < first || c > last) {
+			fprintf(stderr, "note: %s has no '%c', it is drawn as '.'\n", fonts[f].name, c);
+			continue;
+		}
+		charset[glyphs++] = c;
+	}
+	charset[glyphs] = 0;
+
+	//One lookup per character instead of a search through the charset, over the range the subset uses
+	uint8_t mapFirst = charset[0], mapLast = charset[glyphs - 1];
+	size_t mapSize = mapLast - mapFirst + 1;
+	memset(charmap, GLCD_NO_GLYPH, sizeof(charmap));
+	for (size_t g = 0; g < glyphs; g++) charmap[(uint8_t)charset[g] - mapFirst] = g;
+
+	font_table_type_t outType = (fonts[f].type == MIKRO) ? PACKED : fonts[f].type;
+	size_t len = (outType == PACKED) ? glyphs * 2 : 0;
+	for (size_t g = 0; g < glyphs; g++) {
+		const uint8_t *glyph = (const uint8_t *)fonts[f].table + ((uint8_t)charset[g] - first) * glyphBytes;
+		if (outType == PACKED) {
+			subset[g*2] = len & 0xFF;
+			subset[g*2 + 1] = len >> 8;
+			len += packGlyph(glyph, fonts[f].height, bytesHigh, &subset[len]);
+		} else {
+			memcpy(&subset[len], glyph, glyphBytes);
+			len += glyphBytes;
+		}
+	}
+
+	glcd_FontConfig_t original = {fonts[f].table, fonts[f].width, fonts[f].height, first, last, fonts[f].type, NULL};
+	glcd_FontConfig_t sparse = {(const char *)subset, fonts[f].width, fonts[f].height, mapFirst, mapLast, outType, charmap};
+
+	//Every glyph at every row offset within a page must render exactly like the original
+	glcd_select_screen(glcd_buffer, &glcd_bbox);
+	for (size_t g = 0; g < glyphs; g++) {
+		for (uint8_t y = 0; y < 8; y++) {
+			memset(glcd_buffer, 0xA5, FRAME_SIZE);
+			font_current = original;
+			glcd_draw_char_xy(3 + y, y, charset[g]);
+			memcpy(expected, glcd_buffer, FRAME_SIZE);
+
+			memset(glcd_buffer, 0xA5, FRAME_SIZE);
+			font_current = sparse;
+			glcd_draw_char_xy(3 + y, y, charset[g]);
+			if (memcmp(expected, glcd_buffer, FRAME_SIZE) != 0) {
+				fprintf(stderr, "%s: glyph %d at y=%d does not match the original\n", fonts[f].name, charset[g], y);
+				return 1;
+			}
+		}
+	}
+
+	double ratio = secondsPerString(&sparse, charset) / secondsPerString(&original, charset);
+	fprintf(stderr, "%s: %zu of %d glyphs \"%s\", %zu -> %zu bytes (%zu saved), render time %.2fx of the original\n",
+		fonts[f].name, glyphs, last - first + 1, charset, rawSize, len + mapSize, rawSize - len - mapSize, ratio);
+
+	printf("/*\n * %s subset for the screens, %s format(see font_table_type_t). %zu of %d glyphs,\n",
+		fonts[f].name, (outType == PACKED) ? "PACKED" : "STANG", glyphs, last - first + 1);
+	printf(" * %zu bytes with the charmap(original: %zu bytes). Characters \"", len + mapSize, rawSize);
+	for (size_t g = 0; g < glyphs; g++) {
+		//Keep the comment closed
+		printf((charset[g] == '/' && g && charset[g - 1] == '*') ? " %c" : "%c", charset[g]);
+	}
+	printf("\"\n");
+	printf(" * Generated by tools/fonts/mkfonts.sh from lcd/fonts/%s and the strings drawn with %s. Do not edit.\n */\n",
+		fonts[f].header, fonts[f].screenFont);
+	printf("#pragma once\n\n");
+	printf("#define %s_FIRST_CHAR %u\n#define %s_LAST_CHAR %u\n\n", fonts[f].name, mapFirst, fonts[f].name, mapLast);
+	printf("/*Glyph number of every character from %s_FIRST_CHAR to %s_LAST_CHAR, GLCD_NO_GLYPH for the ones left out. See glcd_FontConfig_t.charmap*/\n",
+		fonts[f].name, fonts[f].name);
+	printf("static const uint8_t %s_charmap[] = {", fonts[f].name);
+	for (size_t i = 0; i < mapSize; i++) {
+		printf("%s0x%02X,", (i % 16) ? " " : "\n\t", charmap[i]);
+	}
+	printf("\n};\n\nstatic const char %s_subset[] = {", fonts[f].name);
+	for (size_t i = 0; i < len; i++) {
+		printf("%s0x%02X,", (i % 16) ? " " : "\n\t", subset[i]);
+	}
+	printf("\n};\n");
+	return 0;
+}
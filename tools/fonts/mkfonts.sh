@@ -0,0 +1,26 @@
+#!/bin/bash
+
+# Regenerate the font subsets used by the screens. Run after changing a label or field in lcd/visuals.c.
+# Always with the full frame buffer, whatever the firmware build uses.
+cd "$(dirname "$0")/../.."
+
+gcc -O2 -UGLCD_USE_STRIP_BUFFER -I. -Ilcd -o tools/fonts/mkfonts \
+	tools/fonts/mkfonts.c lcd/text.c lcd/graphics.c lcd/glcd.c \
+	|| exit 1
+
+sources="lcd/visuals.c"
+status=0
+# font name, then the header to write. Into a temporary file first, a failed run leaves the header as it was
+subset() {
+	if tools/fonts/mkfonts "$1" $sources > "$2.new"; then
+		mv "$2.new" "$2"
+	else
+		rm -f "$2.new"
+		status=1
+	fi
+}
+subset Font5x7 lcd/fonts/font5x7_subset.h
+subset Trebuchet_MS13x14 lcd/fonts/font13x14_subset.h
+subset Calibri23x38 lcd/fonts/Calibri23x38_subset.h
+rm -f tools/fonts/mkfonts
+exit $status
@@ -0,0 +1,63 @@
+#!/bin/bash
+
+# Estimate the static RAM and the deepest stack of the firmware with the host gcc, for when the RISC-V toolchain
+# is not at hand. The sources are compiled as 32 bit(-m32, ILP32 like RV32) with 4 byte stack alignment like ILP32E.
+# Inline asm and interrupt attributes are stripped, they only matter to the real target. Sizes are close, the stack
+# depths only a guide: RV32EC has half the registers and spills more, -flto inlines more. The real link checks the
+# headroom with the ASSERT at the end of ch32v003fun/ch32v003fun.ld.
+# The -D build flags of [env:mainLcd] in platformio.ini go to gcc as in the firmware build. Extra arguments go after
+# them, e.g. -UGLCD_USE_STRIP_BUFFER for the full frame buffer.
+cd "$(dirname "$0")/../.."
+
+buildFlags=$(awk '/^\[/ { env = $0 == "[env:mainLcd]" } env && /^build_flags/' platformio.ini | grep -o -- '-D[A-Za-z0-9_=]*')
+
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+mkdir -p "$work/inc"
+#No 32 bit libc headers needed, only the declarations the sources use
+for h in string.h stdio.h stdlib.h; do
+	printf '#pragma once\n#include <stddef.h>\n#include <stdarg.h>\nvoid *memset(void*,int,size_t);void *memcpy(void*,const void*,size_t);void *memmove(void*,const void*,size_t);int memcmp(const void*,const void*,size_t);size_t strlen(const char*);int strcmp(const char*,const char*);int printf(const char*,...);int snprintf(char*,size_t,const char*,...);int abs(int);\n' > "$work/inc/$h"
+done
+printf '#pragma once\n#define INT_MAX 2147483647\n#define CHAR_BIT 8\n' > "$work/inc/limits.h"
+
+for f in src/*.c lcd/*.c; do
+	mkdir -p "$work/src/$(dirname "$f")"
+	perl -0pe 's/asm volatile\(.*?\);//gs; s/__attribute__\(\(interrupt\([^)]*\)\)\)//g' "$f" > "$work/src/$f"
+	(cd "$work" && gcc -m32 -fno-pie -mpreferred-stack-boundary=2 -Os -w -ffreestanding -isystem inc -fno-common -fcallgraph-info=su \
+		-I"$OLDPWD" -I"$OLDPWD/lcd" -I"$OLDPWD/$(dirname "$f")" $buildFlags "$@" -c "src/$f" -o "$(basename "$f" .c).o") || exit 1
+done
+
+echo "Static RAM(.data, .bss, .noinit), largest last:"
+#The CMSIS prescaler tables are static in every file that includes the header, the link drops them
+nm -S -t d "$work"/*.o | awk '$3 ~ /^[bBdD]$/ && $4 !~ /PrescTable$/ {printf "%6d %s\n", $2, $4; total += $2} END {printf "%6d total\n", total}' | sort -n | tail -12
+
+#Code copied to RAM with .data(USE_RAM_FLASH_ROUTINES). x86 code, only a rough guide to the RV32EC size
+size -A "$work"/*.o | awk '$1 ~ /^\.ramfunc/ {total += $2} END {printf "%6d .ramfunc(host code size)\n", total}'
+
+echo "Deepest stack from each entry point, in bytes:"
+cat "$work"/*.ci | awk '
+	function key(t,  n) { if (t in size) return t; n = t; sub(/.*:/, "", n); return (n in byName) ? byName[n] : t }
+	function depth(t, level,  i, c, d, best, bestPath) {
+		t = key(t)
+		if (level > 40 || onPath[t]) return 0
+		onPath[t] = 1; best = 0; bestPath = ""
+		for (i = 1; i <= calls[t]; i++) {
+			d = depth(callee[t, i], level + 1)
+			if (d > best) { best = d; bestPath = path }
+		}
+		onPath[t] = 0
+		c = t; sub(/.*:/, "", c)
+		path = c "(" size[t] + 0 ")" (bestPath == "" ? "" : " > " bestPath)
+		return size[t] + best
+	}
+	/^node:/ && match($0, /[0-9]+ bytes/) {
+		split($0, q, "\""); t = q[2]; size[t] = substr($0, RSTART, RLENGTH) + 0
+		n = t; sub(/.*:/, "", n); if (!(n in byName)) byName[n] = t
+	}
+	/^edge:/ { split($0, q, "\""); calls[q[2]]++; callee[q[2], calls[q[2]]] = q[4] }
+	END {
+		#Callers are keyed by title, local functions carry their file in it
+		for (c in calls) { k = key(c); if (k != c) for (i = 1; i <= calls[c]; i++) { calls[k]++; callee[k, calls[k]] = callee[c, i] } }
+		n = split("main SysTick_Handler PVD_IRQHandler EXTI7_0_IRQHandler", roots, " ")
+		for (r = 1; r <= n; r++) { d = depth(roots[r], 0); printf "%6d %s: %s\n", d, roots[r], path }
+	}'
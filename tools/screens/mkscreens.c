@@ -0,0 +1,247 @@
+/*
+ * Host-side renderer for the firmware screens.
+ *
+ * Runs updateScreen() for a table of machineData_t fixtures, through the real ST7565R driver, with
+ * glcd_spi_write() feeding a model of the controller RAM instead of SPI1. What the model ends up
+ * holding after each frame is what the LCD shows. It is compared with the .pbm files in tools/screens/golden/,
+ * or written there with --update. The fixtures run in order, so the later frames of a screen go
+ * through the incremental paths the way they do on the machine.
+ *
+ * Per frame it prints the glcd_set_pixel() calls, the data and command bytes sent and a cycle
+ * estimate from the two, see CYCLES_PER_SPI_BYTE and CYCLES_PER_SET_PIXEL.
+ *
+ * Build and run through mkscreens.sh.
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "include/main.h"
+#include "include/machineData.h"
+#include "include/speedHistory.h"
+#include "include/mileageLog.h"
+#include "include/jobLog.h"
+#include "lcd/glcd.h"
+#include "lcd/visuals.h"
+
+/*The driver sets the data/command line through LCD_DC_GPIO_PORT->BSHR, point it at RAM*/
+static GPIO_TypeDef dcPort;
+#undef LCD_DC_GPIO_PORT
+#define LCD_DC_GPIO_PORT (&dcPort)
+#include "lcd/controllers/ST7565R.c"
+
+#define LCD_PAGES (GLCD_LCD_HEIGHT / 8)
+/*SPI_BaudRatePrescaler_16 is 128 HCLK per byte on the wire, plus the TXE/BSY polling in glcd_spi_write()*/
+#define CYCLES_PER_SPI_BYTE 140u
+/*Bounds check, read-modify-write and bounding box update on RV32EC. Rough, compare with screenStats.frameCycles*/
+#define CYCLES_PER_SET_PIXEL 40u
+
+/*Things the firmware provides and the lcd/ code links against*/
+machineData_t machineData;
+mileageData_t mileageData;
+mileageLogStats_t mileageLogStats;
+jobRecord_t jobHistoryShown;
+uint32_t sysTickCnt;
+void DelaySysTick(uint32_t n) { (void)n; }
+
+/*Controller model. Only page/column addressing matters for the picture, the rest is counted and dropped*/
+static struct {
+	uint8_t ram[LCD_PAGES][GLCD_NUMBER_OF_COLS];
+	uint8_t page;
+	uint8_t column;
+	uint8_t argumentsToSkip; //Second byte of a two byte command
+	unsigned long dataBytes;
+	unsigned long commandBytes;
+} lcd;
+
+void glcd_spi_write(uint8_t c) {
+	//The driver writes (1 << pin) to raise the line and (1 << (16 + pin)) to drop it
+	static _Bool dataMode;
+	if (dcPort.BSHR & (1u << LCD_DC_GPIO_NUM)) dataMode = true;
+	if (dcPort.BSHR & (1u << (16 + LCD_DC_GPIO_NUM))) dataMode = false;
+	dcPort.BSHR = 0;
+
+	if (dataMode) {
+		lcd.dataBytes++;
+		if (lcd.page < LCD_PAGES && lcd.column < GLCD_NUMBER_OF_COLS) lcd.ram[lcd.page][lcd.column] = c;
+		lcd.column++; //The column address counts up after every data byte
+		return;
+	}
+
+	lcd.commandBytes++;
+	if (lcd.argumentsToSkip) {
+		lcd.argumentsToSkip--;
+	} else if ((c & 0xF0) == ST7565R_PAGE_ADDRESS_SET) {
+		lcd.page = c & 0x0F;
+	} else if ((c & 0xF0) == ST7565R_COLUMN_ADDRESS_SET_UPPER) {
+		lcd.column = (lcd.column & 0x0F) | ((c & 0x0F) << 4);
+	} else if ((c & 0xF0) == ST7565R_COLUMN_ADDRESS_SET_LOWER) {
+		lcd.column = (lcd.column & 0xF0) | (c & 0x0F);
+	} else if (c == 0x81 || c == 0xAD || c == 0xF8) {
+		lcd.argumentsToSkip = 1; //Contrast, static indicator and booster ratio take a value
+	}
+}
+
+/*Count the pixels a frame costs(linked with -Wl,--wrap=glcd_set_pixel)*/
+static unsigned long setPixelCalls;
+void __real_glcd_set_pixel(uint8_t x, uint8_t y, uint8_t color);
+void __wrap_glcd_set_pixel(uint8_t x, uint8_t y, uint8_t color) {
+	setPixelCalls++;
+	__real_glcd_set_pixel(x, y, color);
+}
+
+/*One frame. Everything not listed is 0*/
+typedef struct {
+	const char *name; //Golden file name
+	currentScreen_e screen;
+	uint32_t distance; //In 0.1m
+	uint16_t time; //In minutes
+	int16_t speed; //In m/min
+	batteryState_e battery;
+	_Bool charging;
+	uint32_t sysTickCnt; //Picks the charging blink phase
+	int8_t temperature;
+	uint8_t humidity;
+	uint32_t mileage; //In 0.1m
+	int32_t serviceOverdue; //In m
+	uint16_t onTime; //In minutes
+	uint8_t wear; //In %
+	jobRecord_t job; //jobHistoryShown
+} fixture_t;
+
+static const fixture_t fixtures[] = {
+	{"00_logo",                logoScreen,                0,       0,   0,    full},
+	{"01_distance_zero",       mainScreenDistance,        0,       0,   0,    full},
+	{"02_distance_counting",   mainScreenDistance,        12345,   17,  37,   eightyPercent},
+	{"03_distance_large",      mainScreenDistance,        9876543, 999, 120,  fiftyPercent},
+	{"04_speed",               mainScreenSpeed,           9876543, 999, 42,   fiftyPercent},
+	{"05_speed_changed",       mainScreenSpeed,           9876600, 999, 7,    fiftyPercent},
+	{"06_speed_backwards",     mainScreenSpeed,           9876600, 999, -5,   thirtyPercent},
+	{"07_speed_charging_on",   mainScreenSpeed,           9876600, 999, 0,    tenPercent, true, 0},
+	{"08_speed_charging_off",  mainScreenSpeed,           9876600, 999, 0,    tenPercent, true, BATTERY_CHARGING_BLINK_PERIOD},
+	{"09_speed_charged",       mainScreenSpeed,           9876600, 999, 0,    full},
+	#if defined(USE_SPEED_CHART)
+	{"10_speed_chart",         speedChartScreen,          9876600, 999, 55,   full},
+	#endif
+	#if defined(USE_TEMPERATURE_HUMIDITY_SENSOR)
+	{"11_temperature",         temperatureHumidityScreen, 0,       0,   0,    full, false, 0, 23, 45},
+	{"12_temperature_minus",   temperatureHumidityScreen, 0,       0,   0,    full, false, 0, -12, 98},
+	#endif
+	{"13_settings",            settingsScreen,            0,       0,   0,    full, false, 0, 0, 0, 123456789, 4321, 6789, 7},
+	{"14_settings_overdue",    settingsScreen,            0,       0,   0,    full, false, 0, 0, 0, 500000000, -120, 65535, 100},
+	{"14_settings_due_now",    settingsScreen,            0,       0,   0,    full, false, 0, 0, 0, 500000000, 0, 65535, 100},
+	{"14_settings_serviced",   settingsScreen,            0,       0,   0,    full, false, 0, 0, 0, 500000000, 5000, 65535, 100},
+	{"15_job_history",         jobHistoryScreen,          0,       0,   0,    full, false, 0, 0, 0, 0, 0, 0, 0, {1234, 83, 1234567, 6789, 42, 17}},
+	{"16_service_me",          serviceMeScreen,           0,       0,   0,    full},
+	{"17_low_battery",         lowBatteryScreen,          0,       0,   0,    flat},
+};
+
+
+
+static void loadFixture(const fixture_t *fixture) {
+	machineData.visuals.currentScreen = fixture->screen;
+	machineData.machine.currentDistance = fixture->distance;
+	machineData.machine.time = fixture->time;
+	machineData.machine.speed = fixture->speed;
+	machineData.machine.batteryState = fixture->battery;
+	machineData.flags.batteryCharging = fixture->charging;
+	machineData.machine.outsideTemperature = fixture->temperature;
+	machineData.machine.outsideHumidity = fixture->humidity;
+	mileageData.machineMileage = fixture->mileage;
+	mileageData.serviceOverdue = fixture->serviceOverdue;
+	mileageData.machineOnTimeAge = fixture->onTime;
+	mileageLogStats.wear = fixture->wear;
+	jobHistoryShown = fixture->job;
+	sysTickCnt = fixture->sysTickCnt;
+}
+
+
+
+/**
+ * @brief The controller RAM as a binary PBM(P4), black pixels are 1.
+ *
+ * @return size_t File size
+ */
+static size_t frameToPbm(uint8_t *pbm) {
+	size_t size = sprintf((char *)pbm, "P4\n%u %u\n", GLCD_LCD_WIDTH, GLCD_LCD_HEIGHT);
+
+	for (uint8_t y = 0; y < GLCD_LCD_HEIGHT; y++) {
+		for (uint8_t x = 0; x < GLCD_LCD_WIDTH; x += 8) {
+			uint8_t bits = 0;
+			for (uint8_t i = 0; i < 8; i++) {
+				if (lcd.ram[y / 8][x + i] & (1 << (y % 8))) bits |= 0x80 >> i;
+			}
+			pbm[size++] = bits;
+		}
+	}
+	return size;
+}
+
+
+
+int main(int argc, char **argv) {
+	static uint8_t pbm[32 + GLCD_LCD_WIDTH * GLCD_LCD_HEIGHT / 8];
+	static uint8_t golden[sizeof(pbm) + 1];
+	char path[256];
+	_Bool update = (argc > 1 && strcmp(argv[1], "--update") == 0);
+	unsigned failed = 0;
+
+	glcd_select_screen(glcd_buffer, &glcd_bbox);
+
+	//Something recognisable for the chart: a ramp up, a stop and a slow wave
+	for (int16_t i = 0; i < 128; i++) {
+		int16_t speed = (i < 40) ? i * 2 : (i < 56) ? 0 : 40 + ((i & 31) < 16 ? (i & 15) : 15 - (i & 15)) * 3;
+		speedHistoryAdd(speed);
+		#if defined(USE_SPEED_CHART)
+		advanceSpeedChart();
+		#endif
+	}
+
+	printf("%-24s %9s %9s %9s %10s %s\n", "frame", "setPixels", "data", "commands", "~cycles", "golden");
+	for (size_t f = 0; f < sizeof(fixtures)/sizeof(fixtures[0]); f++) {
+		loadFixture(&fixtures[f]);
+		setPixelCalls = 0;
+		lcd.dataBytes = 0;
+		lcd.commandBytes = 0;
+
+		updateScreen(&machineData);
+
+		size_t size = frameToPbm(pbm);
+		unsigned long cycles = (lcd.dataBytes + lcd.commandBytes) * CYCLES_PER_SPI_BYTE + setPixelCalls * CYCLES_PER_SET_PIXEL;
+		const char *result;
+
+		snprintf(path, sizeof(path), "tools/screens/golden/%s.pbm", fixtures[f].name);
+		if (update) {
+			FILE *file = fopen(path, "wb");
+			if (file == NULL || fwrite(pbm, 1, size, file) != size) {
+				fprintf(stderr, "%s: cannot write\n", path);
+				return 1;
+			}
+			fclose(file);
+			result = "written";
+		} else {
+			FILE *file = fopen(path, "rb");
+			size_t goldenSize = file ? fread(golden, 1, sizeof(golden), file) : 0;
+			if (file) fclose(file);
+			if (goldenSize == size && memcmp(golden, pbm, size) == 0) {
+				result = "same";
+			} else {
+				//Keep what was drawn next to the golden file to look at
+				snprintf(path, sizeof(path), "tools/screens/golden/%s.new.pbm", fixtures[f].name);
+				file = fopen(path, "wb");
+				if (file) {
+					fwrite(pbm, 1, size, file);
+					fclose(file);
+				}
+				result = file ? "DIFFERENT, see .new.pbm" : "DIFFERENT";
+				failed++;
+			}
+		}
+		printf("%-24s %9lu %9lu %9lu %10lu %s\n", fixtures[f].name, setPixelCalls, lcd.dataBytes, lcd.commandBytes, cycles, result);
+	}
+
+	if (failed) {
+		printf("%u frame(s) differ from the golden images\n", failed);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,18 @@
+#!/bin/bash
+
+# Render every screen for the fixtures in mkscreens.c and compare with tools/screens/golden/*.pbm.
+# Run with --update to rewrite the golden images after an intended change of the screens.
+# Built with the -D flags of [env:mainLcd] in platformio.ini, so the counts are those of the firmware build.
+cd "$(dirname "$0")/../.."
+
+buildFlags=$(awk '/^\[/ { env = $0 == "[env:mainLcd]" } env && /^build_flags/' platformio.ini | grep -o -- '-D[A-Za-z0-9_=]*')
+gcc -O2 $buildFlags -I. -Ilcd -Wl,--wrap=glcd_set_pixel -o tools/screens/mkscreens \
+	tools/screens/mkscreens.c src/speedHistory.c lcd/visuals.c lcd/widgets.c lcd/graphics.c lcd/graphs.c lcd/segments.c lcd/overlay.c lcd/text.c lcd/text_tiny.c lcd/glcd.c lcd/pkedLogo.c \
+	|| exit 1
+
+rm -f tools/screens/golden/*.new.pbm
+mkdir -p tools/screens/golden
+tools/screens/mkscreens "$@"
+status=$?
+rm -f tools/screens/mkscreens
+exit $status
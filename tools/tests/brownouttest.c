@@ -0,0 +1,107 @@
+/*
+ * Power cuts against the internal flash mileage log: normal saves and brown-out saves(saveMachineMileageDataOnBrownOut())
+ * are cut after every number of flash operations, tearing the one in progress(tools/tests/flashsim.h). The boot
+ * after has to come back with the new mileage or with the last one that made it, never older and never a fresh
+ * machine. Now and then the erase of the boot is cut as well. A brown-out save right after a normal save or a boot
+ * has to be exactly one page programming cycle, no erase.
+ */
+#include "tools/tests/hosttest.h"
+#include "tools/tests/flashsim.h"
+#include "src/storageFlash.c"
+#include "src/mileageLog.c"
+
+machineData_t machineData;
+mileageData_t mileageData;
+
+
+
+/*The whole save, or as much of it as the supply lasts for. true if it was cut*/
+static bool cutDuring(void (*save)(void), long operations) {
+	flashSimCutAfter(operations);
+	if (setjmp(flashSimCut)) {
+		flashSimCutAfter(-1);
+		return true;
+	}
+	save();
+	flashSimCutAfter(-1);
+	return false;
+}
+
+
+
+static void boot(void) {
+	memset(&machineData, 0, sizeof(machineData));
+	memset(&mileageData, 0, sizeof(mileageData));
+	getSavedMileageDataFromFlash();
+}
+
+
+
+static void step(mileageData_t *data) {
+	uint32_t distance = (rand() % 20) ? rand() % 500 : rand() % 100000;
+	data->machineMileage += distance;
+	data->serviceOverdue -= distance;
+	data->currentDistance = (rand() % 30) ? data->currentDistance + distance : 0;
+	uint16_t minutes = rand() % 3;
+	data->machineOnTimeAge += minutes;
+	data->currentTime += minutes;
+}
+
+
+
+static bool same(const mileageData_t *a, const mileageData_t *b) {
+	return !memcmp(a, b, sizeof(*a));
+}
+
+
+
+int main(void) {
+	hostFlashMap();
+	srand(1);
+	boot();
+	mileageData_t saved = mileageData;
+	bool nextPageErased = true;
+	unsigned long cuts = 0, cameBack = 0, bootCuts = 0, urgentChecked = 0;
+
+	for (int i = 0; i < 200000; i++) {
+		mileageData_t data = saved;
+		step(&data);
+		mileageData = data;
+		machineData.machine.currentDistance = data.currentDistance;
+		machineData.machine.time = data.currentTime;
+
+		bool brownOut = rand() % 4 == 0;
+		long operations = (rand() % 2) ? rand() % 16 : 1000;
+		unsigned long erases = 0, pagePrograms = flashSimPagePrograms, halfWords = flashSimHalfWordPrograms;
+		for (unsigned page = 0; page < FLASH_SIM_PAGES; page++) erases += flashSimErases[page];
+		if (!cutDuring(brownOut ? saveMachineMileageDataOnBrownOut : saveMachineMileageDataToFlash, operations)) {
+			if (brownOut && nextPageErased) {
+				for (unsigned page = 0; page < FLASH_SIM_PAGES; page++) erases -= flashSimErases[page];
+				CHECK(!erases && flashSimPagePrograms - pagePrograms == 1 && flashSimHalfWordPrograms == halfWords,
+					"brown-out save %d: %lu erases, %lu page and %lu halfword programs", i, -erases,
+					flashSimPagePrograms - pagePrograms, flashSimHalfWordPrograms - halfWords);
+				urgentChecked++;
+			}
+			nextPageErased = !brownOut;
+			saved = data;
+			if (rand() % 8) continue;
+			boot();
+			CHECK(same(&mileageData, &saved), "save %d did not come back", i);
+			saved = mileageData;
+			continue;
+		}
+
+		//Power back on, maybe only for as long as the first erase of the boot
+		cuts++;
+		if (rand() % 4 == 0 && cutDuring(boot, 0)) bootCuts++;
+		boot();
+		CHECK(same(&mileageData, &data) || same(&mileageData, &saved), "%s save %d cut after %ld operations: mileage %u, want %u or %u",
+			brownOut ? "brown-out" : "normal", i, operations, mileageData.machineMileage, data.machineMileage, saved.machineMileage);
+		if (same(&mileageData, &data)) cameBack++;
+		saved = mileageData;
+		nextPageErased = true;
+	}
+	printf("%lu saves cut short(%lu of them came back, %lu boots cut short as well), %lu brown-out saves a single page program\n",
+		cuts, cameBack, bootCuts, urgentChecked);
+	return testResult("brownouttest");
+}
@@ -0,0 +1,68 @@
+/*
+ * The speed chart screen frame by frame, through updateScreen() and the real ST7565R driver(tools/tests/lcdsim.h).
+ * 1000 frames of 0 to 3 new speed samples each, now and then a new speed readout, drawn the way the firmware does:
+ * only the chart columns from the old sweep head to the new one(glcd_sweep_graph_draw() in lcd/graphs.c) and the
+ * fields that changed. After every frame the LCD has to show what a full redraw of the screen(invalidateScreen())
+ * shows. runtests.sh builds it with the full frame buffer, with GLCD_USE_STRIP_BUFFER, and with that and
+ * USE_PRERENDERED_BACKGROUNDS as well.
+ */
+#include "tools/tests/hosttest.h"
+#include "tools/tests/lcdsim.h"
+#include "include/machineData.h"
+#include "include/speedHistory.h"
+#include "include/mileageLog.h"
+#include "include/jobLog.h"
+#include "lcd/visuals.h"
+
+#define FRAMES 1000
+
+/*Things the firmware provides and the lcd/ code links against*/
+machineData_t machineData;
+mileageData_t mileageData;
+mileageLogStats_t mileageLogStats;
+jobRecord_t jobHistoryShown;
+uint32_t sysTickCnt;
+
+
+
+int main(void) {
+	static uint8_t got[LCD_SIM_PAGES][GLCD_NUMBER_OF_COLS];
+	unsigned long incrementalBytes = 0, fullBytes = 0, samples = 0;
+
+	srand(1);
+	glcd_select_screen(glcd_buffer, &glcd_bbox);
+	machineData.machine.batteryState = full;
+	machineData.visuals.currentScreen = speedChartScreen;
+	updateScreen(&machineData);
+
+	for (int frame = 0; frame < FRAMES; frame++) {
+		//Stops, crawls and anything up to past the top of the chart
+		int added = rand() % 4;
+		for (int i = 0; i < added; i++, samples++) {
+			speedHistoryAdd((rand() % 5) ? rand() % (SPEED_CHART_FULL_SCALE + 20) : 0);
+			advanceSpeedChart();
+		}
+		if (rand() % 4 == 0) machineData.machine.speed = rand() % 300 - 50;
+
+		unsigned long before = lcdSim.dataBytes;
+		updateScreen(&machineData);
+		incrementalBytes += lcdSim.dataBytes - before;
+		memcpy(got, lcdSim.ram, sizeof(got));
+
+		before = lcdSim.dataBytes;
+		invalidateScreen();
+		updateScreen(&machineData);
+		fullBytes += lcdSim.dataBytes - before;
+		CHECK(!memcmp(got, lcdSim.ram, sizeof(got)), "frame %d, %d samples added: differs from a full redraw", frame, added);
+	}
+
+	printf("%d frames, %lu samples: %lu bytes sent against %lu for full redraws\n", FRAMES, samples, incrementalBytes,
+		fullBytes);
+	#if defined(USE_PRERENDERED_BACKGROUNDS)
+	return testResult("charttest(prerendered backgrounds)");
+	#elif defined(GLCD_USE_STRIP_BUFFER)
+	return testResult("charttest(strip rendering)");
+	#else
+	return testResult("charttest(full frame buffer)");
+	#endif
+}
@@ -0,0 +1,218 @@
+/*
+ * The span kernels of lcd/graphics.c pixel for pixel against glcd_set_pixel() loops: horizontal and vertical lines,
+ * lines in every direction, filled, outlined and thick rectangles, in both colours, over a checkerboard so clearing
+ * shows as well as setting. Random shapes, some running off the right and bottom edges. Drawn through
+ * glcd_render_area() like the screens, so with GLCD_USE_STRIP_BUFFER every page goes through its own pass.
+ * The bounding box has to cover every pixel a shape changed, or the LCD would not get it.
+ */
+#include "tools/tests/hosttest.h"
+#include "lcd/glcd.h"
+
+#define FRAME_SIZE (GLCD_LCD_WIDTH * GLCD_LCD_HEIGHT / 8)
+
+static uint8_t frame[FRAME_SIZE];
+static uint8_t reference[FRAME_SIZE];
+
+/*What the LCD would get*/
+void glcd_write(void) {
+	memcpy(frame + GLCD_BUFFER_OFFSET, glcd_buffer, GLCD_BUFFER_SIZE);
+	glcd_reset_bbox();
+}
+
+void glcd_clear_now(void) {
+}
+
+
+
+static void referencePixel(int x, int y, uint8_t color) {
+	if (x < 0 || y < 0 || x >= GLCD_LCD_WIDTH || y >= GLCD_LCD_HEIGHT) return;
+	if (color) reference[y / 8 * GLCD_LCD_WIDTH + x] |= 1 << (y % 8);
+	else reference[y / 8 * GLCD_LCD_WIDTH + x] &= ~(1 << (y % 8));
+}
+
+
+
+static void referenceRect(int x, int y, int w, int h, uint8_t color) {
+	for (int i = x; i < x + w; i++) {
+		for (int j = y; j < y + h; j++) referencePixel(i, j, color);
+	}
+}
+
+
+
+/*Bresenham as it was before the span kernels, one pixel at a time*/
+static void referenceLine(int x0, int y0, int x1, int y1, uint8_t color) {
+	int steep = abs(y1 - y0) > abs(x1 - x0);
+	int t;
+	if (steep) {
+		t = x0; x0 = y0; y0 = t;
+		t = x1; x1 = y1; y1 = t;
+	}
+	if (x0 > x1) {
+		t = x0; x0 = x1; x1 = t;
+		t = y0; y0 = y1; y1 = t;
+	}
+	int dx = x1 - x0, dy = abs(y1 - y0), err = dx / 2, ystep = (y0 < y1) ? 1 : -1;
+	for (; x0 <= x1; x0++) {
+		if (steep) referencePixel(y0, x0, color);
+		else referencePixel(x0, y0, color);
+		err -= dy;
+		if (err < 0) {
+			y0 += ystep;
+			err += dx;
+		}
+	}
+}
+
+
+
+enum {HLINE, VLINE, LINE, FILL_RECT, DRAW_RECT, THICK_RECT, SHAPES};
+static const char *const shapeNames[SHAPES] = {"hline", "vline", "line", "fill_rect", "draw_rect", "rect_thick"};
+static struct {
+	uint8_t shape, x, y, w, h, tx, ty, color;
+} current;
+
+
+
+static void drawBackground(void) {
+	for (uint8_t y = 0; y < GLCD_LCD_HEIGHT; y++) {
+		for (uint8_t x = (y & 1); x < GLCD_LCD_WIDTH; x += 2) glcd_set_pixel(x, y, 1);
+	}
+}
+
+
+
+static void drawShape(void) {
+	switch (current.shape) {
+	case HLINE: glcd_draw_hline(current.x, current.y, current.w, current.color); break;
+	case VLINE: glcd_draw_vline(current.x, current.y, current.h, current.color); break;
+	case LINE: glcd_draw_line(current.x, current.y, current.w, current.h, current.color); break;
+	case FILL_RECT: glcd_fill_rect(current.x, current.y, current.w, current.h, current.color); break;
+	case DRAW_RECT: glcd_draw_rect(current.x, current.y, current.w, current.h, current.color); break;
+	case THICK_RECT: glcd_draw_rect_thick(current.x, current.y, current.w, current.h, current.tx, current.ty, current.color); break;
+	}
+}
+
+
+
+static void draw(void) {
+	drawBackground();
+	drawShape();
+}
+
+
+
+static void drawReference(void) {
+	memset(reference, 0, sizeof(reference));
+	for (int y = 0; y < GLCD_LCD_HEIGHT; y++) {
+		for (int x = (y & 1); x < GLCD_LCD_WIDTH; x += 2) referencePixel(x, y, 1);
+	}
+	uint8_t background[FRAME_SIZE];
+	memcpy(background, reference, sizeof(background));
+
+	int x = current.x, y = current.y, w = current.w, h = current.h, color = current.color;
+	switch (current.shape) {
+	case HLINE: referenceRect(x, y, w, 1, color); break;
+	case VLINE: referenceRect(x, y, 1, h, color); break;
+	case LINE: referenceLine(x, y, w, h, color); break;
+	case FILL_RECT: referenceRect(x, y, w, h, color); break;
+	case DRAW_RECT:
+		if (!w || !h) break;
+		referenceRect(x, y, w, 1, color);
+		referenceRect(x, y + h - 1, w, 1, color);
+		referenceRect(x, y, 1, h, color);
+		referenceRect(x + w - 1, y, 1, h, color);
+		break;
+	case THICK_RECT: {
+		if (!w || !h) break;
+		int tx = current.tx ? current.tx : 1, ty = current.ty ? current.ty : 1;
+		referenceRect(x, y, w, ty, color);
+		referenceRect(x, y + h - ty, w, ty, color);
+		referenceRect(x, y, tx, h, color);
+		referenceRect(x + w - tx, y, tx, h, color);
+		break;
+	}
+	}
+
+	//Every changed pixel inside the bounding box the shape reported
+	glcd_reset_bbox();
+	#if defined(GLCD_USE_STRIP_BUFFER)
+	glcd_strip_page = GLCD_STRIP_NONE;
+	#endif
+	drawShape();
+	for (int i = 0; i < FRAME_SIZE; i++) {
+		uint8_t changed = reference[i] ^ background[i];
+		for (int bit = 0; bit < 8; bit++) {
+			if (!(changed & (1 << bit))) continue;
+			int px = i % GLCD_LCD_WIDTH, py = i / GLCD_LCD_WIDTH * 8 + bit;
+			if (px < glcd_bbox.x_min || px > glcd_bbox.x_max || py < glcd_bbox.y_min || py > glcd_bbox.y_max) {
+				CHECK(false, "%s(%d, %d, %d, %d) changed %d,%d outside the bounding box", shapeNames[current.shape], x, y, w, h, px, py);
+				return;
+			}
+		}
+	}
+}
+
+
+
+static void testShape(void) {
+	static const glcd_BoundingBox_t screen = {0, 0, GLCD_LCD_WIDTH - 1, GLCD_LCD_HEIGHT - 1};
+	drawReference();
+	memset(glcd_buffer, 0, sizeof(glcd_buffer));
+	glcd_reset_bbox();
+	glcd_render_area(&screen, draw);
+	CHECK(!memcmp(frame, reference, sizeof(frame)), "%s(%d, %d, %d, %d, tx %d, ty %d) colour %d differs", shapeNames[current.shape],
+		current.x, current.y, current.w, current.h, current.tx, current.ty, current.color);
+}
+
+
+
+int main(void) {
+	glcd_select_screen(glcd_buffer, &glcd_bbox);
+	srand(1);
+	unsigned long shapes = 0;
+	for (int i = 0; i < 20000; i++) {
+		current.shape = i % SHAPES;
+		current.color = (i / SHAPES) & 1;
+		//Mostly on the screen, now and then past the right or bottom edge
+		current.x = rand() % (GLCD_LCD_WIDTH + 8);
+		current.y = rand() % (GLCD_LCD_HEIGHT + 8);
+		current.w = (rand() % 4) ? rand() % (GLCD_LCD_WIDTH - current.x % GLCD_LCD_WIDTH + 1) : rand() % 120;
+		current.h = (rand() % 4) ? rand() % (GLCD_LCD_HEIGHT - current.y % GLCD_LCD_HEIGHT + 1) : rand() % 120;
+		//x + w past 255 wraps around in the uint8_t maths, the screens never get there
+		if (current.x + current.w > 255) current.w = 255 - current.x;
+		current.tx = rand() % 5;
+		current.ty = rand() % 5;
+		if (current.shape == LINE) {
+			//Endpoints up to 127, Bresenham keeps its error in an int8_t
+			current.x %= GLCD_LCD_WIDTH;
+			current.w %= GLCD_LCD_WIDTH;
+		}
+		if (current.shape == LINE && (i / SHAPES) % 3 == 0) {
+			//Axis aligned, they take the span kernels
+			if (rand() & 1) current.w = current.x;
+			else current.h = current.y;
+		}
+		testShape();
+		shapes++;
+	}
+
+	//The full-height separators and the full-width rules of the screens, a page boundary on either end
+	for (uint8_t y = 0; y < 16; y++) {
+		for (uint8_t h = 0; h < 20; h++) {
+			current = (typeof(current)){VLINE, 5, y, 0, h, 0, 0, 1};
+			testShape();
+			current = (typeof(current)){FILL_RECT, 3, y, GLCD_LCD_WIDTH, h, 0, 0, y & 1};
+			testShape();
+			shapes += 2;
+		}
+	}
+	printf("%lu shapes drawn, %s\n", shapes,
+	#if defined(GLCD_USE_STRIP_BUFFER)
+		"strip rendering"
+	#else
+		"full frame buffer"
+	#endif
+	);
+	return testResult("drawtest");
+}
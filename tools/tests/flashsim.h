@@ -0,0 +1,94 @@
+/*
+ * The flash routines of src/flash.c for the storage tests, on the flash mapped by hostFlashMap(). An erase sets a page
+ * to 0xFF and programming can only clear bits, like the real flash. Include it after hosttest.h.
+ *
+ * Power cuts: flashSimCutAfter(n) lets n more erase or program operations through and tears the next one, then
+ * longjmp()s to flashSimCut as if the supply had gone. A torn erase leaves each halfword as it was, erased or garbage,
+ * a torn program leaves some bits of the new data programmed and others not.
+ */
+#pragma once
+
+#include <setjmp.h>
+#include "include/flash.h"
+
+#define FLASH_SIM_PAGES (0x4000 / FLASH_PAGE_SIZE)
+
+static jmp_buf flashSimCut;
+static long flashSimBudget = -1; //Operations left before the cut, -1 for no cut
+static unsigned long flashSimErases[FLASH_SIM_PAGES]; //Per page, for the wear
+static unsigned long flashSimPagePrograms, flashSimHalfWordPrograms;
+
+
+
+static inline void flashSimCutAfter(long operations) {
+	flashSimBudget = operations;
+}
+
+
+
+/*True if this operation is the one the power cut tears*/
+static bool flashSimTorn(void) {
+	if (flashSimBudget < 0) return false;
+	return flashSimBudget-- == 0;
+}
+
+
+
+static void flashSimProgram(uint16_t *p, uint16_t data, bool torn) {
+	*p &= torn ? (data | (uint16_t)rand()) : data;
+}
+
+
+
+void flashUnlock(void) {
+}
+
+
+
+void flashErasePage(uint32_t address) {
+	uint16_t *p = (uint16_t *)(uintptr_t)address;
+	if (flashSimTorn()) {
+		for (uint8_t i = 0; i < FLASH_PAGE_SIZE / 2; i++) {
+			if (rand() % 3 == 0) p[i] = 0xFFFF;
+			else if (rand() % 3 == 0) p[i] = rand();
+		}
+		longjmp(flashSimCut, 1);
+	}
+	memset(p, 0xFF, FLASH_PAGE_SIZE);
+	flashSimErases[(address - FLASH_BASE) / FLASH_PAGE_SIZE]++;
+}
+
+
+
+FLASH_Status flashProgramPage(uint32_t address, const uint32_t *data) {
+	uint16_t *p = (uint16_t *)(uintptr_t)address;
+	const uint16_t *halfWords = (const uint16_t *)data;
+	bool torn = flashSimTorn();
+	for (uint8_t i = 0; i < FLASH_PAGE_SIZE / 2; i++) flashSimProgram(&p[i], halfWords[i], torn);
+	if (torn) longjmp(flashSimCut, 1);
+	flashSimPagePrograms++;
+	return FLASH_COMPLETE;
+}
+
+
+
+FLASH_Status FLASH_ProgramHalfWord(uint32_t address, uint16_t data) {
+	bool torn = flashSimTorn();
+	flashSimProgram((uint16_t *)(uintptr_t)address, data, torn);
+	if (torn) longjmp(flashSimCut, 1);
+	flashSimHalfWordPrograms++;
+	return FLASH_COMPLETE;
+}
+
+
+
+/*As in src/flash.c, which the tests can't link: it is the registers behind the routines above*/
+uint16_t crc16(uint16_t crc, const uint8_t *data, uint16_t length) {
+	while (length--) {
+		crc ^= (uint16_t)*data++ << 8;
+		for (uint8_t bit = 0; bit < 8; bit++) {
+			crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+		}
+	}
+	return crc;
+}
@@ -0,0 +1,68 @@
+/*
+ * Shared by the host tests in tools/tests, include it first. The tests build the firmware sources with the host gcc,
+ * see runtests.sh.
+ *
+ * CHECK() counts a failure and prints the first few, testResult() prints the verdict and gives the exit code.
+ * The peripherals the sources under test touch are plain structs in RAM, set them up from the test as needed.
+ */
+#pragma once
+
+#define _GNU_SOURCE
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+
+#include "ch32v003fun/ch32v003fun.h"
+
+static unsigned long failures;
+
+#define CHECK(condition, ...) do { \
+	if (!(condition) && failures++ < 10) { \
+		printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+		printf(__VA_ARGS__); \
+		printf("\n"); \
+	} \
+} while (0)
+
+static inline int testResult(const char *name) {
+	printf("%s: %s\n", name, failures ? "FAILED" : "ok");
+	return failures != 0;
+}
+
+static inline double secondsNow(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+/*Peripherals, in RAM instead of at their addresses. Not every test touches every one*/
+static SysTick_Type hostSysTick __attribute__((unused));
+static RCC_TypeDef hostRcc __attribute__((unused));
+static PWR_TypeDef hostPwr __attribute__((unused));
+#undef SysTick
+#define SysTick (&hostSysTick)
+#undef RCC
+#define RCC (&hostRcc)
+#undef PWR
+#define PWR (&hostPwr)
+
+/*Which interrupts are masked, for the tests that play interrupts. NVIC_SystemReset() ends the test, nothing may need it*/
+static uint8_t irqMasked[64] __attribute__((unused));
+#define NVIC_DisableIRQ(irq) ((void)(irqMasked[(irq) & 63] = 1))
+#define NVIC_EnableIRQ(irq) ((void)(irqMasked[(irq) & 63] = 0))
+#define NVIC_SystemReset() do { printf("FAIL: NVIC_SystemReset()\n"); exit(1); } while (0)
+
+void DelaySysTick(uint32_t n) { (void)n; }
+
+/*The flash, 16KB at FLASH_BASE like on the chip, so the FLASH_ADDR_... constants work as they are. All erased*/
+static inline void hostFlashMap(void) {
+	void *flash = mmap((void *)(uintptr_t)FLASH_BASE, 0x4000, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+	if (flash != (void *)(uintptr_t)FLASH_BASE) {
+		perror("mmap of the flash address range");
+		exit(1);
+	}
+	memset(flash, 0xFF, 0x4000);
+}
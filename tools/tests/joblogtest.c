@@ -0,0 +1,198 @@
+/*
+ * The job log of src/jobLog.c on the simulated flash(tools/tests/flashsim.h). Jobs are appended many times round the
+ * ring and every job kept has to read back by its age, before and after a boot that scans the slots again. An append
+ * is the 8 halfword programs of one record, with one erase when the head gets to a page; a read costs the same at any
+ * age. A job with no distance and no time is not logged. The pages wear evenly, and nothing outside the job log area
+ * is erased or written, the mileage log least of all. Then power cuts during appends: the boot after gives the new
+ * job whole or the one before it as the newest, and the next append goes on past the torn slot.
+ */
+#include "tools/tests/hosttest.h"
+#include "tools/tests/flashsim.h"
+#include "src/jobLog.c"
+
+#define FIRST_PAGE (((uintptr_t)FLASH_ADDR_TO_STORE_JOB_LOG - FLASH_BASE) / FLASH_PAGE_SIZE)
+#define RUNS 10u //Times round the ring
+#define READS 2000000l
+
+static uint8_t flashBefore[0x4000];
+
+
+
+static void boot(void) {
+	head = 0x5A;
+	count = 0xA5;
+	nextSequence = 0x1234;
+	jobLogInit();
+}
+
+
+
+static jobRecord_t randomJob(void) {
+	jobRecord_t job = {0};
+	job.distance = 1 + rand() % 100000;
+	job.time = rand() % 600;
+	job.endOnTime = rand();
+	job.maxSpeed = rand();
+	job.avgSpeed = rand();
+	job.reason = rand() % 3;
+	return job;
+}
+
+
+
+static bool sameJob(const jobRecord_t *a, const jobRecord_t *b) {
+	return a->distance == b->distance && a->time == b->time && a->endOnTime == b->endOnTime && a->maxSpeed == b->maxSpeed &&
+		a->avgSpeed == b->avgSpeed && a->reason == b->reason;
+}
+
+
+
+/*Every job the ring can hold has to come back, newest first*/
+static void checkJobs(const jobRecord_t *appended, unsigned long total, const char *when) {
+	uint8_t expected = total < JOB_LOG_SLOTS ? total : JOB_LOG_SLOTS;
+	CHECK(jobLogCount() >= expected - (total >= JOB_LOG_SLOTS ? JOB_LOG_SLOTS_PER_PAGE : 0) && jobLogCount() <= expected,
+		"%s, job %lu: %u jobs kept, want up to %u", when, total, jobLogCount(), expected);
+	for (uint8_t age = 0; age < jobLogCount(); age++) {
+		jobRecord_t job;
+		CHECK(jobLogGet(age, &job) && sameJob(&job, &appended[(total - 1 - age) % JOB_LOG_SLOTS]), "%s, job %lu: age %u wrong",
+			when, total, age);
+	}
+	jobRecord_t job;
+	CHECK(!jobLogGet(jobLogCount(), &job), "%s: a job older than the count reads", when);
+}
+
+
+
+static void testRing(void) {
+	jobRecord_t appended[JOB_LOG_SLOTS];
+	unsigned long total = 0, pageCrossings = 0;
+	boot();
+	CHECK(jobLogCount() == 0, "blank flash gives %u jobs", jobLogCount());
+
+	for (unsigned long i = 0; i < RUNS * JOB_LOG_SLOTS; i++) {
+		unsigned long erases = 0, halfWords = flashSimHalfWordPrograms;
+		for (unsigned page = 0; page < FLASH_SIM_PAGES; page++) erases += flashSimErases[page];
+		bool pageStart = head % JOB_LOG_SLOTS_PER_PAGE == 0;
+
+		jobRecord_t job = randomJob();
+		appended[total % JOB_LOG_SLOTS] = job;
+		jobLogAppend(&job);
+		total++;
+
+		for (unsigned page = 0; page < FLASH_SIM_PAGES; page++) erases -= flashSimErases[page];
+		erases = -erases;
+		CHECK(flashSimHalfWordPrograms - halfWords == sizeof(jobRecord_t) / 2 && erases <= (pageStart && total > JOB_LOG_SLOTS),
+			"append %lu: %lu halfword programs and %lu erases", total, flashSimHalfWordPrograms - halfWords, erases);
+		if (pageStart && erases) pageCrossings++;
+
+		checkJobs(appended, total, "after the append");
+		if (rand() % 3 == 0) {
+			boot();
+			checkJobs(appended, total, "after a boot");
+		}
+
+		//Nothing to keep: no flash operation and the same jobs
+		if (rand() % 4 == 0) {
+			jobRecord_t empty = randomJob();
+			empty.distance = 0;
+			empty.time = 0;
+			halfWords = flashSimHalfWordPrograms;
+			jobLogAppend(&empty);
+			CHECK(flashSimHalfWordPrograms == halfWords, "an empty job was logged");
+			checkJobs(appended, total, "after an empty job");
+		}
+	}
+
+	unsigned long least = ~0ul, most = 0;
+	for (unsigned i = 0; i < JOB_LOG_PAGES; i++) {
+		if (flashSimErases[FIRST_PAGE + i] < least) least = flashSimErases[FIRST_PAGE + i];
+		if (flashSimErases[FIRST_PAGE + i] > most) most = flashSimErases[FIRST_PAGE + i];
+	}
+	printf("%lu jobs in a ring of %u slots, %lu page erases, %lu..%lu a page\n", total, (unsigned)JOB_LOG_SLOTS, pageCrossings,
+		least, most);
+	CHECK(most - least <= 1, "uneven wear, %lu..%lu erases a page", least, most);
+}
+
+
+
+/*The oldest job has to cost no more to read than the newest*/
+static void testReadCost(void) {
+	jobRecord_t job;
+	volatile uint16_t sink = 0;
+	double seconds[2];
+	for (int oldest = 0; oldest < 2; oldest++) {
+		uint8_t age = oldest ? jobLogCount() - 1 : 0;
+		double start = secondsNow();
+		for (long i = 0; i < READS; i++) {
+			jobLogGet(age, &job);
+			sink += job.crc;
+		}
+		seconds[oldest] = secondsNow() - start;
+	}
+	printf("host timing: %.1f ns to read the newest job, %.1f ns the oldest of %u\n", seconds[0] * 1e9 / READS,
+		seconds[1] * 1e9 / READS, jobLogCount());
+	CHECK(seconds[1] < seconds[0] * 3, "reading the oldest job takes %.1fx as long", seconds[1] / seconds[0]);
+}
+
+
+
+/*Cut the supply during appends, the boot after gives the new job or the one before it as the newest*/
+static void testPowerCuts(void) {
+	//Across the setjmp()
+	static unsigned long cuts, madeWhole;
+	static int i;
+	for (i = 0; i < 2000; i++) {
+		boot();
+		jobRecord_t newest = {0}, job = randomJob(), read;
+		bool hadJobs = jobLogGet(0, &newest);
+		flashSimCutAfter(rand() % 12);
+		if (setjmp(flashSimCut) == 0) {
+			jobLogAppend(&job);
+			flashSimCutAfter(-1);
+			continue;
+		}
+
+		flashSimCutAfter(-1);
+		cuts++;
+		boot();
+		bool madeIt = jobLogGet(0, &read) && sameJob(&read, &job);
+		CHECK(madeIt || (hadJobs ? jobLogGet(0, &read) && sameJob(&read, &newest) : jobLogCount() == 0),
+			"cut %d: the newest job is neither the torn one nor the one before", i);
+		if (madeIt) madeWhole++;
+	}
+	boot();
+	jobRecord_t job = randomJob(), read;
+	jobLogAppend(&job);
+	boot();
+	CHECK(jobLogGet(0, &read) && sameJob(&read, &job), "no job logged after the power cuts");
+	printf("2000 appends, %lu cut short, %lu of those made it whole anyway\n", cuts, madeWhole);
+}
+
+
+
+int main(void) {
+	hostFlashMap();
+	srand(1);
+	//Something in the mileage log and everywhere else, to see that it stays
+	for (int i = 0; i < 0x4000; i++) ((uint8_t *)FLASH_BASE)[i] = rand();
+	memset(FLASH_ADDR_TO_STORE_JOB_LOG, 0xFF, JOB_LOG_STORAGE_SIZE);
+	memcpy(flashBefore, (void *)FLASH_BASE, sizeof(flashBefore));
+
+	CHECK((uintptr_t)FLASH_ADDR_TO_STORE_JOB_LOG + JOB_LOG_STORAGE_SIZE <= (uintptr_t)FLASH_ADDR_TO_STORE_BACKUP_DATA ||
+		(uintptr_t)FLASH_ADDR_TO_STORE_BACKUP_DATA + NON_VOLATILE_FLASH_DATA_STORAGE_SIZE <= (uintptr_t)FLASH_ADDR_TO_STORE_JOB_LOG,
+		"the job log area overlaps the mileage log");
+	testRing();
+	testReadCost();
+	testPowerCuts();
+
+	uintptr_t start = (uintptr_t)FLASH_ADDR_TO_STORE_JOB_LOG - FLASH_BASE;
+	for (unsigned page = 0; page < FLASH_SIM_PAGES; page++) {
+		if (page < FIRST_PAGE || page >= FIRST_PAGE + JOB_LOG_PAGES) {
+			CHECK(!flashSimErases[page], "page %u outside the job log erased", page);
+		}
+	}
+	CHECK(!memcmp(flashBefore, (void *)FLASH_BASE, start) &&
+		!memcmp(flashBefore + start + JOB_LOG_STORAGE_SIZE, (uint8_t *)FLASH_BASE + start + JOB_LOG_STORAGE_SIZE,
+		sizeof(flashBefore) - start - JOB_LOG_STORAGE_SIZE), "flash outside the job log changed");
+	return testResult("joblogtest");
+}
@@ -0,0 +1,61 @@
+/*
+ * The real ST7565R driver of lcd/controllers/ST7565R.c for the drawing tests, with glcd_spi_write() feeding a model of
+ * the controller RAM instead of SPI1, as in tools/screens/mkscreens.c. What lcdSim.ram holds is what the LCD shows.
+ * Include it after hosttest.h.
+ */
+#pragma once
+
+#include "include/main.h"
+#include "lcd/glcd.h"
+
+/*The driver sets the data/command line through LCD_DC_GPIO_PORT->BSHR, point it at RAM*/
+static GPIO_TypeDef lcdSimDcPort;
+#undef LCD_DC_GPIO_PORT
+#define LCD_DC_GPIO_PORT (&lcdSimDcPort)
+#include "lcd/controllers/ST7565R.c"
+
+#define LCD_SIM_PAGES (GLCD_LCD_HEIGHT / 8)
+
+/*Only page/column addressing matters for the picture, the rest is counted and dropped*/
+static struct {
+	uint8_t ram[LCD_SIM_PAGES][GLCD_NUMBER_OF_COLS];
+	uint8_t page;
+	uint8_t column;
+	uint8_t argumentsToSkip; //Second byte of a two byte command
+	unsigned long dataBytes;
+} lcdSim;
+
+
+
+void glcd_spi_write(uint8_t c) {
+	//The driver writes (1 << pin) to raise the line and (1 << (16 + pin)) to drop it
+	static bool dataMode;
+	if (lcdSimDcPort.BSHR & (1u << LCD_DC_GPIO_NUM)) dataMode = true;
+	if (lcdSimDcPort.BSHR & (1u << (16 + LCD_DC_GPIO_NUM))) dataMode = false;
+	lcdSimDcPort.BSHR = 0;
+
+	if (dataMode) {
+		lcdSim.dataBytes++;
+		if (lcdSim.page < LCD_SIM_PAGES && lcdSim.column < GLCD_NUMBER_OF_COLS) lcdSim.ram[lcdSim.page][lcdSim.column] = c;
+		lcdSim.column++; //The column address counts up after every data byte
+		return;
+	}
+
+	if (lcdSim.argumentsToSkip) {
+		lcdSim.argumentsToSkip--;
+	} else if ((c & 0xF0) == ST7565R_PAGE_ADDRESS_SET) {
+		lcdSim.page = c & 0x0F;
+	} else if ((c & 0xF0) == ST7565R_COLUMN_ADDRESS_SET_UPPER) {
+		lcdSim.column = (lcdSim.column & 0x0F) | ((c & 0x0F) << 4);
+	} else if ((c & 0xF0) == ST7565R_COLUMN_ADDRESS_SET_LOWER) {
+		lcdSim.column = (lcdSim.column & 0xF0) | (c & 0x0F);
+	} else if (c == 0x81 || c == 0xAD || c == 0xF8) {
+		lcdSim.argumentsToSkip = 1; //Contrast, static indicator and booster ratio take a value
+	}
+}
+
+
+
+static inline bool lcdSimPixel(uint8_t x, uint8_t y) {
+	return lcdSim.ram[y / 8][x] >> (y % 8) & 1;
+}
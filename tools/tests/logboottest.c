@@ -0,0 +1,160 @@
+/*
+ * Boot of the internal flash mileage log(src/storageFlash.c through src/mileageLog.c): every save comes back on the
+ * next boot, a corrupted newest record gives the one before it, corruption in the other pages changes nothing,
+ * an area of garbage boots as a fresh machine. Then the boot time with a full page of records to replay.
+ */
+#include "tools/tests/hosttest.h"
+#include "tools/tests/flashsim.h"
+#include "src/storageFlash.c"
+#include "src/mileageLog.c"
+
+machineData_t machineData;
+mileageData_t mileageData;
+
+
+
+static void boot(void) {
+	memset(&machineData, 0, sizeof(machineData));
+	memset(&mileageData, 0xA5, sizeof(mileageData));
+	getSavedMileageDataFromFlash();
+}
+
+
+
+static void save(const mileageData_t *data) {
+	mileageData = *data;
+	machineData.machine.currentDistance = data->currentDistance;
+	machineData.machine.time = data->currentTime;
+	saveMachineMileageDataToFlash();
+}
+
+
+
+/*A wheel pulse or two most of the time, a minute now and then, a job end, once in a while a jump*/
+static void step(mileageData_t *data) {
+	uint32_t distance = (rand() % 50) ? rand() % 300 : rand() % 200000;
+	data->machineMileage += distance;
+	data->serviceOverdue -= distance / 10;
+	data->currentDistance += distance;
+	uint16_t minutes = rand() % 3;
+	data->machineOnTimeAge += minutes;
+	data->currentTime += minutes;
+	if (rand() % 40 == 0) {
+		data->currentDistance = 0;
+		data->currentTime = 0;
+	}
+}
+
+
+
+static bool booted(const mileageData_t *data) {
+	return !memcmp(&mileageData, data, sizeof(*data)) && machineData.machine.currentDistance == data->currentDistance &&
+		machineData.machine.time == data->currentTime;
+}
+
+
+
+/*Offset and CRC-covered length of the record the last save wrote, from the write head before and after it*/
+static uint16_t newestRecord(uint16_t headBefore, uint8_t *length) {
+	if (writeOffset % FLASH_PAGE_SIZE == SNAPSHOT_SIZE) {
+		*length = SNAPSHOT_SIZE;
+		return writeOffset - SNAPSHOT_SIZE;
+	}
+	*length = DELTA_HEADER_SIZE + *areaAddress(headBefore);
+	return headBefore;
+}
+
+
+
+static void flipBit(uint16_t offset, uint8_t length) {
+	((uint8_t *)areaAddress(offset))[rand() % length] ^= 1 << (rand() % 8);
+}
+
+
+
+int main(void) {
+	hostFlashMap();
+	srand(1);
+
+	boot();
+	CHECK(mileageData.machineMileage == 0 && mileageData.serviceOverdue == MACHINE_SERVICE_INTERVALS, "blank flash is not a fresh machine");
+
+	mileageData_t data = mileageData;
+	for (int i = 0; i < 5000; i++) {
+		step(&data);
+		save(&data);
+		boot();
+		CHECK(booted(&data), "save %d lost, mileage %u instead of %u", i, mileageData.machineMileage, data.machineMileage);
+	}
+
+	//The newest record corrupted: the one before. Then the log carries on
+	unsigned long snapshots = 0, deltas = 0;
+	for (int i = 0; i < 2000; i++) {
+		//A few saves first, so the corrupted one lands anywhere in its page
+		for (int n = rand() % 6; n; n--) {
+			step(&data);
+			save(&data);
+		}
+		mileageData_t before = data;
+		step(&data);
+		uint16_t head = writeOffset;
+		save(&data);
+		uint8_t length;
+		uint16_t offset = newestRecord(head, &length);
+		(length == SNAPSHOT_SIZE) ? snapshots++ : deltas++;
+		flipBit(offset, length);
+		boot();
+		CHECK(booted(&before), "corrupted %s at %u: mileage %u, want %u", (length == SNAPSHOT_SIZE) ? "snapshot" : "delta", offset,
+			mileageData.machineMileage, before.machineMileage);
+		mileageData_t after = data;
+		step(&after);
+		save(&after);
+		boot();
+		CHECK(booted(&after), "no save after a corrupted record");
+		data = after;
+	}
+	printf("corrupted the newest record %lu times as a snapshot, %lu as a delta\n", snapshots, deltas);
+
+	//Any other page corrupted: the newest record all the same
+	for (int i = 0; i < 2000; i++) {
+		step(&data);
+		save(&data);
+		uint16_t page = (writeOffset - 1) / FLASH_PAGE_SIZE * FLASH_PAGE_SIZE;
+		uint16_t other = (page + FLASH_PAGE_SIZE * (1 + rand() % (MILEAGE_LOG_PAGES - 1))) % LOG_SIZE;
+		flipBit(other, FLASH_PAGE_SIZE);
+		boot();
+		CHECK(booted(&data), "corrupting page %u lost the newest record in page %u", other, page);
+	}
+
+	//Garbage everywhere: a fresh machine, and the log works from there
+	for (uint16_t i = 0; i < LOG_SIZE; i++) ((uint8_t *)areaAddress(0))[i] = rand();
+	boot();
+	CHECK(mileageData.machineMileage == 0 && mileageData.serviceOverdue == MACHINE_SERVICE_INTERVALS, "garbage is not a fresh machine");
+	data = mileageData;
+	for (int i = 0; i < 100; i++) {
+		step(&data);
+		save(&data);
+	}
+	boot();
+	CHECK(booted(&data), "saves after garbage lost");
+
+	//Boot time, with the newest page as full of deltas as it gets
+	while (writeOffset % FLASH_PAGE_SIZE != SNAPSHOT_SIZE) {
+		data.machineMileage++;
+		save(&data);
+	}
+	int replayed = 0;
+	while (writeOffset + DELTA_HEADER_SIZE + 1 <= PAGE_END(writeOffset - 1)) {
+		data.machineMileage++;
+		save(&data);
+		replayed++;
+	}
+	enum {BOOTS = 100000};
+	double start = secondsNow();
+	for (int i = 0; i < BOOTS; i++) getSavedMileageDataFromFlash();
+	double elapsed = secondsNow() - start;
+	CHECK(booted(&data), "full page lost");
+	printf("host timing, boot: %d pages scanned, a snapshot and %d deltas replayed in %.0f ns\n", MILEAGE_LOG_PAGES, replayed,
+		elapsed / BOOTS * 1e9);
+	return testResult("logboottest");
+}
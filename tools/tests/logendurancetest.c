@@ -0,0 +1,148 @@
+/*
+ * Endurance of the internal flash mileage log: a machine at work, measuring runs and stops, a few power-offs a day,
+ * saved on the checkpoints of include/mileageLog.h, until the most worn page of the ring reaches
+ * FLASH_ENDURANCE_CYCLES. The pages have to wear evenly, a page has to take at least MILEAGE_LOG_SAVES_PER_ERASE
+ * saves and the log has to outlast the design life. Then the worst case, every save a full size delta.
+ */
+#include "tools/tests/hosttest.h"
+#include "tools/tests/flashsim.h"
+#include "src/storageFlash.c"
+#include "src/mileageLog.c"
+
+machineData_t machineData;
+mileageData_t mileageData;
+
+#define FIRST_PAGE (((uintptr_t)FLASH_ADDR_TO_STORE_BACKUP_DATA - FLASH_BASE) / FLASH_PAGE_SIZE)
+
+
+
+static unsigned long mostWorn(void) {
+	unsigned long most = 0;
+	for (unsigned i = 0; i < MILEAGE_LOG_PAGES; i++) {
+		if (flashSimErases[FIRST_PAGE + i] > most) most = flashSimErases[FIRST_PAGE + i];
+	}
+	return most;
+}
+
+
+
+static unsigned long leastWorn(void) {
+	unsigned long least = flashSimErases[FIRST_PAGE];
+	for (unsigned i = 1; i < MILEAGE_LOG_PAGES; i++) {
+		if (flashSimErases[FIRST_PAGE + i] < least) least = flashSimErases[FIRST_PAGE + i];
+	}
+	return least;
+}
+
+
+
+static unsigned long allErases(void) {
+	unsigned long erases = 0;
+	for (unsigned i = 0; i < MILEAGE_LOG_PAGES; i++) erases += flashSimErases[FIRST_PAGE + i];
+	return erases;
+}
+
+
+
+static void wipe(void) {
+	memset((void *)areaAddress(0), 0xFF, LOG_SIZE);
+	memset(flashSimErases, 0, sizeof(flashSimErases));
+	memset(&mileageLogStats, 0, sizeof(mileageLogStats));
+	getSavedMileageDataFromFlash();
+}
+
+
+
+/*One second of on time at speed, in 0.1m/s. Distance goes up by the wheel pulse like in the encoder interrupt*/
+static void second(uint16_t speed, uint16_t *seconds) {
+	for (uint16_t d = 0; d < speed; d += COUNTER_STEP) {
+		mileageData.machineMileage += COUNTER_STEP;
+		mileageData.serviceOverdue -= COUNTER_STEP;
+		machineData.machine.currentDistance += COUNTER_STEP;
+		if (mileageLogCheckpointDue()) saveMachineMileageDataToFlash();
+	}
+	if (++*seconds == 60) {
+		*seconds = 0;
+		mileageData.machineOnTimeAge++;
+		machineData.machine.time++;
+		if (mileageLogCheckpointDue()) saveMachineMileageDataToFlash();
+	}
+}
+
+
+
+/*
+ * Until the flash wears out: days of 8 hours on in two to four sessions, each one runs of 1 to 10 minutes at
+ * 3 to 6km/h between stops of up to 20 minutes, and a job finished now and then. A save at every power-off
+ */
+static void typicalUse(void) {
+	wipe();
+	unsigned long days = 0, onSeconds = 0;
+	uint64_t distance = 0;
+	while (mostWorn() < FLASH_ENDURANCE_CYCLES) {
+		days++;
+		int sessions = 2 + rand() % 3;
+		for (int s = 0; s < sessions; s++) {
+			uint16_t seconds = 0;
+			for (long left = 8 * 3600 / sessions; left > 0; ) {
+				uint16_t speed = (rand() & 1) ? 8 + rand() % 9 : 0;
+				for (int t = speed ? 60 + rand() % 540 : rand() % 1200; t > 0 && left > 0; t--, left--) {
+					second(speed, &seconds);
+					distance += speed;
+					onSeconds++;
+				}
+				if (rand() % 10 == 0) {
+					machineData.machine.currentDistance = 0;
+					machineData.machine.time = 0;
+				}
+			}
+			saveMachineMileageDataToFlash();
+		}
+	}
+
+	unsigned long saves = mileageLogStats.saves;
+	double km = distance / 10000.0, hours = onSeconds / 3600.0, savesPerErase = (double)saves / allErases();
+	printf("typical: %lu saves(%.1f a day), %.2f per page erase, %lu..%lu erases a page\n",
+		saves, (double)saves / days, savesPerErase, leastWorn(), mostWorn());
+	printf("typical: worn out after %.0f km and %.0f hours on(design life %u km, %u hours), wear shows %u%%\n",
+		km, hours, MACHINE_DESIGN_LIFE_DISTANCE, MACHINE_DESIGN_LIFE_ON_TIME, mileageLogStats.wear);
+	for (unsigned perDay = 10; perDay <= 1000; perDay *= 10) {
+		printf("typical: %u saves a day wear the log out in %.1f years\n", perDay,
+			savesPerErase * FLASH_ENDURANCE_CYCLES * MILEAGE_LOG_PAGES / perDay / 365);
+	}
+
+	CHECK(mostWorn() - leastWorn() <= 1, "uneven wear, %lu..%lu erases a page", leastWorn(), mostWorn());
+	CHECK(savesPerErase >= MILEAGE_LOG_SAVES_PER_ERASE, "%.2f saves per erase, MILEAGE_LOG_SAVES_PER_ERASE is %u",
+		savesPerErase, MILEAGE_LOG_SAVES_PER_ERASE);
+	CHECK(km >= MACHINE_DESIGN_LIFE_DISTANCE || hours >= MACHINE_DESIGN_LIFE_ON_TIME, "worn out before the design life");
+	CHECK(mileageLogStats.wear >= 99 && mileageLogStats.wear <= 100, "wear shows %u%% worn out", mileageLogStats.wear);
+}
+
+
+
+/*Every field changes by as much as it can between saves, every delta at its longest*/
+static void worstCase(void) {
+	wipe();
+	while (mostWorn() < FLASH_ENDURANCE_CYCLES / 100) {
+		mileageData.machineMileage += 0x10000000u + rand();
+		mileageData.serviceOverdue = (int32_t)((uint32_t)mileageData.serviceOverdue - 0x10000000u - rand());
+		machineData.machine.currentDistance += 0x10000000u + rand();
+		mileageData.machineOnTimeAge += 0x4000u + rand() % 0x4000;
+		machineData.machine.time += 0x4000u + rand() % 0x4000;
+		saveMachineMileageDataToFlash();
+	}
+	double savesPerErase = (double)mileageLogStats.saves / allErases();
+	printf("worst case: %.2f saves per page erase, %.0f saves to wear out\n", savesPerErase,
+		savesPerErase * FLASH_ENDURANCE_CYCLES * MILEAGE_LOG_PAGES);
+	CHECK(savesPerErase >= 2, "%.2f saves per erase in the worst case", savesPerErase);
+}
+
+
+
+int main(void) {
+	hostFlashMap();
+	srand(1);
+	typicalUse();
+	worstCase();
+	return testResult("logendurancetest");
+}
@@ -0,0 +1,144 @@
+/*
+ * The delta records of src/storageFlash.c: encodeDelta() and decodeDelta() round trip over full range values, and a
+ * body one byte short or long does not decode. Then through the log, every kind of change a field can take(wheel
+ * pulses, minutes, job resets, a service, a reversing wheel, counters wrapping) has to come back exactly from a
+ * boot after every save. Prints how many records a page takes against whole records.
+ */
+#include "tools/tests/hosttest.h"
+#include "tools/tests/flashsim.h"
+#include "src/storageFlash.c"
+#include "src/mileageLog.c"
+
+machineData_t machineData;
+mileageData_t mileageData;
+
+
+
+static uint32_t random32(void) {
+	//Mostly any value, now and then one next to 0 or to a wrap
+	switch (rand() % 4) {
+	case 0: return rand() % 4;
+	case 1: return -(uint32_t)(rand() % 4);
+	case 2: return 0x7FFFFFFEu + rand() % 4;
+	}
+	return (uint32_t)rand() << 16 ^ rand();
+}
+
+
+
+static void randomData(mileageData_t *data) {
+	data->machineMileage = random32();
+	data->currentDistance = random32();
+	data->serviceOverdue = (int32_t)random32();
+	data->machineOnTimeAge = random32();
+	data->currentTime = random32();
+}
+
+
+
+static void testRoundTrip(void) {
+	unsigned long longest = 0;
+	for (int i = 0; i < 1000000; i++) {
+		mileageData_t data, decoded;
+		randomData(&snapshot);
+		randomData(&data);
+		if (rand() & 1) {
+			//Close to the snapshot, the usual case
+			data = snapshot;
+			data.machineMileage += rand() % 3000;
+			data.currentDistance = (rand() % 8) ? data.currentDistance + rand() % 3000 : 0;
+			data.serviceOverdue -= rand() % 300;
+			data.machineOnTimeAge += rand() % 30;
+			data.currentTime = (rand() % 8) ? data.currentTime + rand() % 30 : 0;
+		}
+		uint8_t body[DELTA_MAX_BODY + 1];
+		uint8_t length = encodeDelta(body, &data);
+		if (length > longest) longest = length;
+		CHECK(length <= DELTA_MAX_BODY, "delta body of %u bytes", length);
+		CHECK(decodeDelta(body, length, &decoded) && !memcmp(&decoded, &data, sizeof(data)), "round trip of mileage %u against %u",
+			data.machineMileage, snapshot.machineMileage);
+		CHECK(!decodeDelta(body, length - 1, &decoded), "a body one byte short decodes");
+		body[length] = 0;
+		CHECK(!decodeDelta(body, length + 1, &decoded), "a body one byte long decodes");
+	}
+	printf("1000000 deltas round trip, the longest body %lu bytes(DELTA_MAX_BODY %u)\n", longest, DELTA_MAX_BODY);
+}
+
+
+
+/*What the machine does to the fields between two saves*/
+static void change(mileageData_t *data) {
+	uint32_t distance;
+	switch (rand() % 10) {
+	case 0: //A job finished
+		data->currentDistance = 0;
+		data->currentTime = 0;
+		break;
+	case 1: //Serviced
+		data->serviceOverdue = MACHINE_SERVICE_INTERVALS;
+		break;
+	case 2: //Wheel turned backwards, the job distance goes down with the mileage left alone
+		data->currentDistance -= rand() % 100;
+		break;
+	case 3: //Overdue a long time
+		data->serviceOverdue = -(int32_t)(rand() % 1000000);
+		break;
+	case 4: //Counters about to wrap
+		data->machineMileage = 0xFFFFFFFFu - rand() % 2000;
+		data->machineOnTimeAge = 0xFFFFu - rand() % 20;
+		data->currentTime = 0xFFFFu - rand() % 20;
+		break;
+	default: //Wheel pulses and minutes
+		distance = rand() % 2000;
+		data->machineMileage += distance;
+		data->currentDistance += distance;
+		data->serviceOverdue -= distance;
+		data->machineOnTimeAge += rand() % 3;
+		data->currentTime += rand() % 3;
+		break;
+	}
+}
+
+
+
+static void testReplay(void) {
+	getSavedMileageDataFromFlash();
+	mileageData_t data = mileageData;
+	memset(&mileageLogStats, 0, sizeof(mileageLogStats));
+	for (int i = 0; i < 100000; i++) {
+		change(&data);
+		mileageData = data;
+		machineData.machine.currentDistance = data.currentDistance;
+		machineData.machine.time = data.currentTime;
+		saveMachineMileageDataToFlash();
+
+		memset(&mileageData, 0, sizeof(mileageData));
+		getSavedMileageDataFromFlash();
+		CHECK(!memcmp(&mileageData, &data, sizeof(data)), "save %d replayed as mileage %u time %u, saved %u %u", i,
+			mileageData.machineMileage, mileageData.currentTime, data.machineMileage, data.currentTime);
+		CHECK(machineData.machine.currentDistance == data.currentDistance && machineData.machine.time == data.currentTime,
+			"save %d job counters", i);
+	}
+	printf("%lu saves replayed, %.2f records a page, %u as whole records\n", (unsigned long)mileageLogStats.saves,
+		(double)mileageLogStats.saves / mileageLogStats.pageWrites, (unsigned)(FLASH_PAGE_SIZE / SNAPSHOT_SIZE));
+
+	//Just the wheel, one pulse at a time: the smallest delta
+	uint8_t body[DELTA_MAX_BODY + 1];
+	snapshot = data;
+	data.machineMileage += COUNTER_STEP;
+	data.currentDistance += COUNTER_STEP;
+	data.serviceOverdue -= COUNTER_STEP;
+	uint8_t length = encodeDelta(body, &data);
+	printf("a wheel pulse: %u byte delta, a %u byte snapshot\n", deltaSize(length), (unsigned)SNAPSHOT_SIZE);
+	CHECK(length == 5, "a wheel pulse takes a %u byte body", length);
+}
+
+
+
+int main(void) {
+	hostFlashMap();
+	srand(1);
+	testRoundTrip();
+	testReplay();
+	return testResult("logreplaytest");
+}
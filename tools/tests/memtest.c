@@ -0,0 +1,120 @@
+/*
+ * memset(), memcpy() and memmove() of ch32v003fun.c against byte by byte references, for every alignment of
+ * the destination and the source and every length up to a few word loops, plus the framebuffer sizes. Checks the
+ * bytes around the destination as well, the word loops must not write past it. memmove() both ways round with
+ * overlap. Then a host timing of the framebuffer clear, word loops against the byte loop they replaced.
+ *
+ * runtests.sh takes the three functions out of ch32v003fun.c into memfun.c, renamed to funMemset... here.
+ */
+#include "tools/tests/hosttest.h"
+
+#define memset funMemset
+#define memcpy funMemcpy
+#define memmove funMemmove
+void *memset(void *dest, int c, size_t n);
+void *memcpy(void *dest, const void *src, size_t n);
+void *memmove(void *dest, const void *src, size_t n);
+#include "memfun.c"
+#undef memset
+#undef memcpy
+#undef memmove
+
+#define GLCD_BUFFER_SIZE 1024
+#define GUARD 16
+#define BUFFER_SIZE (GLCD_BUFFER_SIZE + 2 * GUARD + 8)
+
+static uint8_t dst[BUFFER_SIZE] __attribute__((aligned(8)));
+static uint8_t ref[BUFFER_SIZE] __attribute__((aligned(8)));
+static uint8_t src[BUFFER_SIZE] __attribute__((aligned(8)));
+
+static const size_t lengths[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 15, 16, 17, 31, 32, 33, 47, 48, 63, 64, 65, 71, 100, 255, 256, 257, 1023, GLCD_BUFFER_SIZE};
+
+
+
+static void fill(uint8_t *p, size_t n, unsigned seed) {
+	for (size_t i = 0; i < n; i++) p[i] = (uint8_t)(i * 131 + seed * 7 + 1);
+}
+
+
+
+static void testSetAndCopy(void) {
+	fill(src, sizeof(src), 3);
+	for (size_t l = 0; l < sizeof(lengths) / sizeof(*lengths); l++) {
+		size_t n = lengths[l];
+		for (int d = 0; d < 8; d++) {
+			fill(dst, sizeof(dst), d);
+			fill(ref, sizeof(ref), d);
+			for (size_t i = 0; i < n; i++) ref[GUARD + d + i] = 0xA5;
+			CHECK(funMemset(dst + GUARD + d, 0xA5, n) == dst + GUARD + d, "memset return");
+			CHECK(!memcmp(dst, ref, sizeof(dst)), "memset dst+%d n %zu", d, n);
+
+			for (int s = 0; s < 8; s++) {
+				fill(dst, sizeof(dst), d);
+				fill(ref, sizeof(ref), d);
+				for (size_t i = 0; i < n; i++) ref[GUARD + d + i] = src[s + i];
+				CHECK(funMemcpy(dst + GUARD + d, src + s, n) == dst + GUARD + d, "memcpy return");
+				CHECK(!memcmp(dst, ref, sizeof(dst)), "memcpy dst+%d src+%d n %zu", d, s, n);
+			}
+		}
+	}
+}
+
+
+
+static void testMove(void) {
+	//Both inside one buffer, every offset between them either way round, overlapping or not
+	for (size_t n = 0; n <= 40; n++) {
+		for (int from = 0; from < 48; from++) {
+			for (int to = 0; to < 48; to++) {
+				fill(dst, 128, n);
+				fill(ref, 128, n);
+				uint8_t copy[64];
+				for (size_t i = 0; i < n; i++) copy[i] = ref[GUARD + from + i];
+				for (size_t i = 0; i < n; i++) ref[GUARD + to + i] = copy[i];
+				CHECK(funMemmove(dst + GUARD + to, dst + GUARD + from, n) == dst + GUARD + to, "memmove return");
+				CHECK(!memcmp(dst, ref, 128), "memmove from %d to %d n %zu", from, to, n);
+			}
+		}
+	}
+}
+
+
+
+/*What memset() was before, the compiler must not turn it back into a call*/
+__attribute__((noinline, optimize("no-tree-loop-distribute-patterns")))
+static void byteMemset(void *dest, int c, size_t n) {
+	unsigned char *s = dest;
+	for (; n; n--) *s++ = c;
+}
+
+
+
+static void benchmarkClear(void) {
+	enum {ROUNDS = 200000};
+	double start = secondsNow();
+	for (int i = 0; i < ROUNDS; i++) {
+		byteMemset(dst, 0, GLCD_BUFFER_SIZE);
+		__asm__ volatile("" : : "r"(dst) : "memory");
+	}
+	double bytes = secondsNow() - start;
+	start = secondsNow();
+	for (int i = 0; i < ROUNDS; i++) {
+		funMemset(dst, 0, GLCD_BUFFER_SIZE);
+		__asm__ volatile("" : : "r"(dst) : "memory");
+	}
+	double words = secondsNow() - start;
+	//Host nanoseconds say little about the RV32EC, the store counts are what carries over
+	printf("host timing, 1KB framebuffer clear: byte loop %.0f ns, word loops %.0f ns, %.1fx\n",
+		bytes / ROUNDS * 1e9, words / ROUNDS * 1e9, bytes / words);
+	printf("on the target: %u byte stores against %u word stores in %u rounds of the unrolled loop\n",
+		(unsigned)GLCD_BUFFER_SIZE, (unsigned)GLCD_BUFFER_SIZE / 4, (unsigned)GLCD_BUFFER_SIZE / 16);
+}
+
+
+
+int main(void) {
+	testSetAndCopy();
+	testMove();
+	benchmarkClear();
+	return testResult("memtest");
+}
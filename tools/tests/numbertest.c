@@ -0,0 +1,139 @@
+/*
+ * The printf-free number fields of lcd/text.c. glcd_div10() against the / and % of the host over the ends of the
+ * uint32_t range and random values. glcd_format_number() against snprintf() for random values and formats: width,
+ * scale, decimals, zero padding, signed and unsigned. Then glcd_draw_number_xy() has to draw the same pixels as
+ * glcd_draw_string_xy() of the snprintf() string.
+ */
+#include "tools/tests/hosttest.h"
+#include "lcd/text.c"
+#include "lcd/fonts/font5x7.h"
+
+#define FRAME_SIZE (GLCD_LCD_WIDTH * GLCD_LCD_HEIGHT / 8)
+#define FORMATS 300000
+#define MAX_SCALE 4
+#define REFERENCE_SIZE 48
+
+void glcd_write(void) {
+	glcd_reset_bbox();
+}
+
+void glcd_clear_now(void) {
+}
+
+
+
+static void testDiv10(void) {
+	unsigned long checked = 0;
+	for (uint64_t i = 0; i < 3000000; i++) {
+		//The low end, the high end, then random values
+		uint32_t n = i < 1000000 ? i : i < 2000000 ? 0xFFFFFFFFu - (i - 1000000) : (uint32_t)rand() << 16 ^ rand();
+		uint8_t rem;
+		uint32_t q = glcd_div10(n, &rem);
+		CHECK(q == n / 10 && rem == n % 10, "glcd_div10(%u) gave %u remainder %u", n, q, rem);
+		checked++;
+	}
+	printf("glcd_div10: %lu values\n", checked);
+}
+
+
+
+/*What the format has to print, from snprintf(). randomFormat() keeps to the widths and decimals the fields use*/
+static void reference(char out[REFERENCE_SIZE], int32_t value, const glcd_NumberFormat_t *format) {
+	bool isUnsigned = format->flags & GLCD_NUMBER_UNSIGNED;
+	bool negative = !isUnsigned && value < 0;
+	uint64_t n = isUnsigned ? (uint32_t)value : negative ? -(int64_t)value : value;
+	uint64_t divisor = 1, shown = 1;
+	int decimals = format->decimals < MAX_SCALE ? format->decimals : MAX_SCALE;
+	int width = format->width < GLCD_NUMBER_MAX_WIDTH ? format->width : GLCD_NUMBER_MAX_WIDTH;
+	for (uint8_t i = format->decimals; i < format->scale; i++) divisor *= 10;
+	for (int i = 0; i < decimals; i++) shown *= 10;
+	n /= divisor;
+	if (n == 0) negative = false;
+
+	char number[24];
+	if (decimals) {
+		snprintf(number, sizeof(number), "%llu.%0*llu", (unsigned long long)(n / shown), decimals, (unsigned long long)(n % shown));
+	} else {
+		snprintf(number, sizeof(number), "%llu", (unsigned long long)n);
+	}
+	//Zeros go after the sign like %0*d, spaces before it
+	int pad = width - negative - (int)strlen(number);
+	if (pad < 0) pad = 0;
+	if (format->flags & GLCD_NUMBER_ZERO_PAD) {
+		snprintf(out, REFERENCE_SIZE, "%s%.*s%s", negative ? "-" : "", pad, "0000000000000000", number);
+	} else {
+		snprintf(out, REFERENCE_SIZE, "%*s%s%s", pad, "", negative ? "-" : "", number);
+	}
+}
+
+
+
+static glcd_NumberFormat_t randomFormat(void) {
+	glcd_NumberFormat_t format;
+	format.scale = rand() % (MAX_SCALE + 1);
+	format.decimals = rand() % (format.scale + 1);
+	format.width = rand() % (GLCD_NUMBER_MAX_WIDTH + 1);
+	format.flags = rand() & (GLCD_NUMBER_ZERO_PAD | GLCD_NUMBER_UNSIGNED);
+	return format;
+}
+
+
+
+static int32_t randomValue(void) {
+	switch (rand() % 4) {
+	case 0: return rand() % 2000 - 1000;
+	case 1: return INT32_MIN + rand() % 3;
+	case 2: return INT32_MAX - rand() % 3;
+	}
+	return (uint32_t)rand() << 16 ^ rand();
+}
+
+
+
+static void testFormat(void) {
+	for (int i = 0; i < FORMATS; i++) {
+		glcd_NumberFormat_t format = randomFormat();
+		int32_t value = randomValue();
+		char str[GLCD_NUMBER_MAX_WIDTH + 1], expected[REFERENCE_SIZE];
+		char *p = glcd_format_number(str, value, &format);
+		reference(expected, value, &format);
+		CHECK(!strcmp(p, expected) && str[GLCD_NUMBER_MAX_WIDTH] == '\0',
+			"%d(width %u scale %u decimals %u flags %u) gave \"%s\", snprintf \"%s\"", value, format.width, format.scale,
+			format.decimals, format.flags, p, expected);
+	}
+	printf("glcd_format_number: %d values and formats against snprintf\n", FORMATS);
+}
+
+
+
+/*Both ways onto a checkerboard, the pixels have to be the same*/
+static void testDraw(void) {
+	static uint8_t drawn[FRAME_SIZE];
+	glcd_select_screen(glcd_buffer, &glcd_bbox);
+	glcd_font(Font5x7, 5, 7, 32, 127, STANG);
+	for (int i = 0; i < FORMATS / 10; i++) {
+		glcd_NumberFormat_t format = randomFormat();
+		int32_t value = randomValue();
+		char expected[REFERENCE_SIZE];
+		reference(expected, value, &format);
+		uint8_t x = rand() % 40, y = rand() % (GLCD_LCD_HEIGHT - 8);
+
+		for (int b = 0; b < FRAME_SIZE; b++) glcd_buffer[b] = b & 1 ? 0x55 : 0xAA;
+		glcd_draw_number_xy(x, y, value, &format);
+		memcpy(drawn, glcd_buffer, FRAME_SIZE);
+		for (int b = 0; b < FRAME_SIZE; b++) glcd_buffer[b] = b & 1 ? 0x55 : 0xAA;
+		glcd_draw_string_xy(x, y, expected);
+		CHECK(!memcmp(drawn, glcd_buffer, FRAME_SIZE), "%d drawn as \"%s\" differs", value, expected);
+	}
+	printf("glcd_draw_number_xy: %d numbers pixel for pixel against glcd_draw_string_xy()\n", FORMATS / 10);
+}
+
+
+
+int main(void) {
+	srand(1);
+	testDiv10();
+	testFormat();
+	testDraw();
+	return testResult("numbertest");
+}
@@ -0,0 +1,250 @@
+/*
+ * Wheel pulses and SysTick ticks through the checkpoints: a timeline of the flash busy windows against the encoder
+ * and SysTick interrupts, with the real src/flash.c, src/isr.c and the internal flash log. The flash stalls every
+ * instruction fetch from it while it erases or programs, so during a busy window an interrupt only runs at once if
+ * the code polling the flash and the handler are both in .ramfunc. Otherwise it stays pending until the flash is
+ * done, and a second pulse in the same window is lost. Where each function is comes from the section headers of
+ * this executable, so it is what RAM_FUNCTION really did to it(built -no-pie by runtests.sh).
+ *
+ * Pulses come every 1.3 to 1.7ms, much faster than the machine goes, so several fall into every page erase and
+ * program. Saves every 100ms, as main.c does them with SysTick masked. With USE_RAM_FLASH_ROUTINES no pulse may
+ * be lost, and SysTick has to catch up on every tick either way. Then the same again as if nothing were in RAM,
+ * to see what the option saves.
+ */
+#include "tools/tests/hosttest.h"
+#include <elf.h>
+
+//Every flash register access goes through hostFlashAccess(), which moves the timeline on
+static FLASH_TypeDef *hostFlashAccess(void);
+#undef FLASH
+#define FLASH (hostFlashAccess())
+
+//Unmasking runs what is pending
+static void hostIrqEnable(int irq);
+#undef NVIC_EnableIRQ
+#define NVIC_EnableIRQ(irq) hostIrqEnable(irq)
+
+//First, before anything includes main.h: RAM_FUNCTION as src/flash.c gets it in the firmware build
+#include "src/flash.c"
+
+static GPIO_TypeDef hostGpio[4];
+static TIM_TypeDef hostTim1;
+static EXTI_TypeDef hostExti;
+#undef GPIOv_to_GPIObase
+#define GPIOv_to_GPIObase(GPIOv) (&hostGpio[(GPIOv) >> 4])
+#undef GPIOC
+#define GPIOC (&hostGpio[GPIO_port_C])
+#undef TIM1
+#define TIM1 (&hostTim1)
+#undef EXTI
+#define EXTI (&hostExti)
+
+#define interrupt(type)
+#include "src/isr.c"
+#undef interrupt
+#include "src/storageFlash.c"
+#include "src/mileageLog.c"
+
+machineData_t machineData;
+mileageData_t mileageData;
+uint32_t sysTickCnt;
+
+static unsigned long sleeps;
+
+void goToSleep(void) {
+	sleeps++;
+}
+
+uint8_t jobLogCount(void) {
+	return 0;
+}
+
+#define CYCLES_PER_US (FUNCONF_SYSTEM_CORE_CLOCK / 1000000u)
+#define CYCLES_PER_MS (FUNCONF_SYSTEM_CORE_CLOCK / 1000u)
+#define ACCESS_CYCLES 24u //A register access and the loop around it
+#define PAGE_BUSY_US 3000u //Page erase or page program
+#define HALFWORD_BUSY_US 50u
+#define RUN_SECONDS 120
+
+static FLASH_TypeDef hostFlash;
+static uint64_t now, busyUntil; //In HCLK cycles
+static uint32_t eraseAddress; //The page the erase in progress is for, 0 for none
+static bool halfWordStarted;
+static uint64_t nextPulse;
+static bool extiPending, sysTickPending, inInterrupt, codeInRam;
+static unsigned long pulses;
+
+//Where .ramfunc is, and whether to take it into account
+static uintptr_t ramStart, ramEnd;
+static bool ramFunctions;
+
+
+
+static bool inRam(const void *code) {
+	return ramFunctions && (uintptr_t)code >= ramStart && (uintptr_t)code < ramEnd;
+}
+
+
+
+static void findRamFunctions(void) {
+	FILE *f = fopen("/proc/self/exe", "rb");
+	Elf64_Ehdr header;
+	if (!f || fread(&header, sizeof(header), 1, f) != 1) return;
+	Elf64_Shdr sections[header.e_shnum];
+	fseek(f, header.e_shoff, SEEK_SET);
+	if (fread(sections, sizeof(*sections), header.e_shnum, f) != header.e_shnum) return;
+	char names[sections[header.e_shstrndx].sh_size];
+	fseek(f, sections[header.e_shstrndx].sh_offset, SEEK_SET);
+	if (fread(names, 1, sizeof(names), f) != sizeof(names)) return;
+	for (int i = 0; i < header.e_shnum; i++) {
+		if (!strcmp(names + sections[i].sh_name, ".ramfunc")) {
+			ramStart = sections[i].sh_addr;
+			ramEnd = ramStart + sections[i].sh_size;
+		}
+	}
+	fclose(f);
+}
+
+
+
+static bool busy(void) {
+	return now < busyUntil;
+}
+
+
+
+static bool mayRun(const void *handler, int irq) {
+	if (inInterrupt || irqMasked[irq]) return false;
+	return !busy() || (codeInRam && inRam(handler));
+}
+
+
+
+static void serviceInterrupts(void) {
+	if (extiPending && mayRun(EXTI7_0_IRQHandler, EXTI7_0_IRQn)) {
+		extiPending = false;
+		inInterrupt = true;
+		EXTI7_0_IRQHandler();
+		inInterrupt = false;
+	}
+	if (sysTickPending && mayRun(SysTick_Handler, SysTicK_IRQn)) {
+		sysTickPending = false;
+		inInterrupt = true;
+		SysTick->CNT = (uint32_t)now;
+		SysTick_Handler();
+		inInterrupt = false;
+	}
+}
+
+
+
+/*Move the timeline on: pulses, SysTick compare matches and the end of the busy window, in order*/
+static void advance(uint64_t cycles) {
+	uint64_t end = now + cycles;
+	for (;;) {
+		//The compare only matches on equality, behind CNT it is 2^32 cycles away
+		uint64_t tick = now + (uint32_t)(SysTick->CMP - (uint32_t)now - 1) + 1;
+		uint64_t next = end;
+		if (nextPulse < next) next = nextPulse;
+		if (tick < next) next = tick;
+		if (busy() && busyUntil < next) next = busyUntil;
+		now = next;
+
+		if (eraseAddress && !busy()) {
+			memset((void *)(uintptr_t)eraseAddress, 0xFF, FLASH_PAGE_SIZE);
+			eraseAddress = 0;
+		}
+		if (now == nextPulse) {
+			pulses++;
+			extiPending = true;
+			nextPulse += (1300 + rand() % 400) * CYCLES_PER_US;
+		}
+		if (now == tick) sysTickPending = true;
+		serviceInterrupts();
+		if (now == end) return;
+	}
+}
+
+
+
+/*Starts what the register writes since the last access asked for, then one access worth of time*/
+__attribute__((noinline)) static FLASH_TypeDef *hostFlashAccess(void) {
+	codeInRam = inRam(__builtin_return_address(0));
+	if (hostFlash.CTLR & CR_STRT_Set) {
+		//Page erase or page program, the program has gone into the page already through the buffer loads
+		hostFlash.CTLR &= ~CR_STRT_Set;
+		busyUntil = now + PAGE_BUSY_US * CYCLES_PER_US;
+		if (hostFlash.CTLR & CR_PAGE_ER) eraseAddress = hostFlash.ADDR;
+	}
+	if ((hostFlash.CTLR & CR_PG_Set) && !halfWordStarted) {
+		halfWordStarted = true;
+		busyUntil = now + HALFWORD_BUSY_US * CYCLES_PER_US;
+	}
+	if (!(hostFlash.CTLR & CR_PG_Set)) halfWordStarted = false;
+
+	advance(ACCESS_CYCLES);
+	hostFlash.STATR = busy() ? FLASH_STATR_BSY : 0;
+	return &hostFlash;
+}
+
+
+
+static void hostIrqEnable(int irq) {
+	irqMasked[irq] = 0;
+	serviceInterrupts();
+}
+
+
+
+/*Checkpoints every 100ms, the rest of the time the main loop has nothing to do. Returns the pulses lost*/
+static unsigned long run(bool withRamFunctions) {
+	ramFunctions = withRamFunctions;
+	memset((void *)FLASH_ADDR_TO_STORE_BACKUP_DATA, 0xFF, NON_VOLATILE_FLASH_DATA_STORAGE_SIZE);
+	memset(&mileageData, 0, sizeof(mileageData));
+	memset(&machineData, 0, sizeof(machineData));
+	memset(&mileageLogStats, 0, sizeof(mileageLogStats));
+	pulses = 0;
+	sysTickCnt = 0;
+	uint64_t start = now;
+	SysTick->CMP = (uint32_t)now + CYCLES_PER_MS;
+	nextPulse = now + CYCLES_PER_MS / 2;
+	getSavedMileageDataFromFlash();
+
+	for (int i = 0; i < RUN_SECONDS * 10; i++) {
+		advance(100 * CYCLES_PER_MS);
+		NVIC_DisableIRQ(SysTicK_IRQn);
+		NVIC_DisableIRQ(PVD_IRQn);
+		saveMachineMileageDataToFlash();
+		machineData.requests.checkpointRq = false;
+		NVIC_EnableIRQ(PVD_IRQn);
+		NVIC_EnableIRQ(SysTicK_IRQn);
+	}
+	//Whatever is pending runs before the count
+	advance(10 * CYCLES_PER_MS);
+
+	unsigned long counted = mileageData.machineMileage / COUNTER_STEP, ticks = (now - start) / CYCLES_PER_MS;
+	printf("%s: %lu saves, %lu page erases and programs, %lu pulses, %lu counted, %lu lost; %lu of %lu ticks\n",
+		withRamFunctions ? "flash routines and encoder interrupt in RAM" : "all in flash",
+		(unsigned long)mileageLogStats.saves, (unsigned long)mileageLogStats.pageWrites * 2, pulses, counted,
+		pulses - counted, (unsigned long)sysTickCnt, ticks);
+	CHECK(sysTickCnt == ticks, "SysTick counted %u ms of %lu", sysTickCnt, ticks);
+	CHECK(!sleeps, "went to sleep");
+	return pulses - counted;
+}
+
+
+
+int main(void) {
+	hostFlashMap();
+	findRamFunctions();
+	srand(1);
+	unsigned long lost = run(true);
+	#if defined(USE_RAM_FLASH_ROUTINES)
+	CHECK(ramStart != ramEnd, "nothing in .ramfunc");
+	CHECK(inRam(EXTI7_0_IRQHandler) && inRam(flashErasePage) && inRam(flashProgramPage) && inRam(FLASH_ProgramHalfWord),
+		"the encoder interrupt or a flash routine is not in .ramfunc");
+	CHECK(!lost, "%lu pulses lost with USE_RAM_FLASH_ROUTINES", lost);
+	#endif
+	run(false);
+	return testResult("pulselosstest");
+}
@@ -0,0 +1,243 @@
+/*
+ * The incremental redraws of the lcd/ library against full redraws, through the real ST7565R driver(tools/tests/lcdsim.h).
+ * Each step draws only what changed and sends it the way the screens do: glcd_write() of the bounding box with the
+ * full frame buffer, or with GLCD_USE_STRIP_BUFFER the bounding box of the drawing with no page visible, replayed
+ * through glcd_render_area(). The LCD then has to show exactly what a full redraw of the whole screen shows.
+ * runtests.sh builds it both ways.
+ *
+ * Seven-segment numbers(lcd/segments.c): random styles, formats and places, in a field over a background of lines, each
+ * number going through a run of values, mostly small steps and now and then a jump that changes its length.
+ *
+ * Overlays(lcd/overlay.c): random lists of OR, XOR and clear rectangles with random blink phases, some running past
+ * the edges, over a background that gets a line now and then. Each step swaps the list, changes the phase or draws,
+ * and the LCD also has to show the overlays composited pixel by pixel onto the background without them.
+ */
+#include "tools/tests/hosttest.h"
+#include "tools/tests/lcdsim.h"
+
+#define CASES 3000
+#define STEPS 30
+
+static const glcd_BoundingBox_t wholeScreen = {0, 0, GLCD_LCD_WIDTH - 1, GLCD_LCD_HEIGHT - 1};
+static uint8_t got[LCD_SIM_PAGES][GLCD_NUMBER_OF_COLS];
+static unsigned long incrementalBytes, fullBytes;
+
+//What the draw functions below draw, glcd_render_area() takes no arguments
+static struct {
+	uint8_t x, y;
+	int32_t value;
+	glcd_NumberFormat_t format;
+	glcd_SegmentStyle_t style;
+	uint8_t lines[4 + STEPS][4];
+	uint8_t lineCount;
+} scene;
+
+void glcd_reset(void) {
+}
+
+
+
+static void drawBackground(void) {
+	memset(glcd_buffer_selected, 0, GLCD_BUFFER_SIZE);
+	for (int i = 0; i < scene.lineCount; i++) glcd_draw_line(scene.lines[i][0], scene.lines[i][1], scene.lines[i][2], scene.lines[i][3], BLACK);
+}
+
+
+
+/*In a box to the right edge, cleared like drawWidget() clears a seven-segment field: the number owns the cells it had*/
+static void drawSegmentsFull(void) {
+	drawBackground();
+	glcd_fill_rect(scene.x, scene.y, GLCD_LCD_WIDTH - scene.x, scene.style.height, WHITE);
+	glcd_draw_segment_number_xy(scene.x, scene.y, scene.value, NULL, &scene.format, &scene.style);
+}
+
+
+
+/*Send what an incremental draw changed, on top of what is in the bounding box already, as renderScreen() does*/
+static void sendChanges(void (*drawIncremental)(void), void (*drawFull)(void)) {
+	unsigned long before = lcdSim.dataBytes;
+	#if defined(GLCD_USE_STRIP_BUFFER)
+	glcd_strip_page = GLCD_STRIP_NONE;
+	drawIncremental();
+	glcd_BoundingBox_t area = glcd_bbox;
+	glcd_render_area(&area, drawFull);
+	#else
+	(void)drawFull;
+	drawIncremental();
+	glcd_write();
+	#endif
+	incrementalBytes += lcdSim.dataBytes - before;
+}
+
+
+
+/*Everything redrawn and sent. true if the LCD showed that already*/
+static bool sameAsFull(void (*drawFull)(void)) {
+	memcpy(got, lcdSim.ram, sizeof(got));
+	unsigned long before = lcdSim.dataBytes;
+	glcd_render_area(&wholeScreen, drawFull);
+	fullBytes += lcdSim.dataBytes - before;
+	return !memcmp(got, lcdSim.ram, sizeof(got));
+}
+
+
+
+static void randomLine(uint8_t line[4]) {
+	line[0] = rand() % GLCD_LCD_WIDTH;
+	line[1] = rand() % GLCD_LCD_HEIGHT;
+	line[2] = rand() % GLCD_LCD_WIDTH;
+	line[3] = rand() % GLCD_LCD_HEIGHT;
+}
+
+
+
+static void randomScene(void) {
+	scene.lineCount = 4;
+	for (int i = 0; i < 4; i++) randomLine(scene.lines[i]);
+}
+
+
+
+static int32_t previousValue;
+
+static void drawSegmentsChange(void) {
+	glcd_draw_segment_number_xy(scene.x, scene.y, scene.value, &previousValue, &scene.format, &scene.style);
+}
+
+
+
+static void testSegments(void) {
+	unsigned long steps = 0;
+	incrementalBytes = fullBytes = 0;
+	for (int c = 0; c < CASES; c++) {
+		randomScene();
+		scene.style.thickness = 1 + rand() % 4;
+		scene.style.width = 2 * scene.style.thickness + 1 + rand() % 12;
+		scene.style.height = 3 * scene.style.thickness + 2 + rand() % 30;
+		scene.style.spacing = rand() % 4;
+		scene.format.scale = rand() % 3;
+		scene.format.decimals = rand() % (scene.format.scale + 1);
+		scene.format.width = rand() % 6;
+		scene.format.flags = rand() & (GLCD_NUMBER_ZERO_PAD | GLCD_NUMBER_UNSIGNED);
+		scene.x = rand() % 64;
+		scene.y = rand() % (GLCD_LCD_HEIGHT - scene.style.height + 1);
+		scene.value = rand() % 2000 - 1000;
+		glcd_render_area(&wholeScreen, drawSegmentsFull);
+
+		for (int s = 0; s < STEPS; s++) {
+			previousValue = scene.value;
+			scene.value += (rand() % 8) ? rand() % 21 - 10 : rand() % 200000 - 100000;
+			glcd_reset_bbox();
+			sendChanges(drawSegmentsChange, drawSegmentsFull);
+			CHECK(sameAsFull(drawSegmentsFull), "case %d step %d: %d after %d(width %u thickness %u height %u) differs from a full redraw",
+				c, s, scene.value, previousValue, scene.style.width, scene.style.thickness, scene.style.height);
+			steps++;
+		}
+	}
+	printf("seven-segment: %lu changes, %lu bytes sent against %lu for full redraws\n", steps, incrementalBytes, fullBytes);
+}
+
+
+
+//Two tables taking turns, glcd_set_overlays() only looks at the pointer and the count
+static glcd_Overlay_t overlayTables[2][GLCD_MAX_OVERLAYS];
+static uint8_t overlayTable, overlayCount, overlayPhase;
+
+static void randomOverlays(void) {
+	overlayTable ^= 1;
+	overlayCount = rand() % (GLCD_MAX_OVERLAYS + 1);
+	for (int i = 0; i < overlayCount; i++) {
+		glcd_Overlay_t *overlay = &overlayTables[overlayTable][i];
+		overlay->x = rand() % GLCD_LCD_WIDTH;
+		overlay->y = rand() % GLCD_LCD_HEIGHT;
+		//Up to 16 pixels past the right and bottom edges, now and then empty
+		overlay->w = rand() % (GLCD_LCD_WIDTH - overlay->x + 17);
+		overlay->h = rand() % (GLCD_LCD_HEIGHT - overlay->y + 17);
+		overlay->op = rand() % 3;
+		overlay->phases = (rand() % 3) ? rand() : GLCD_OVERLAY_ALWAYS;
+	}
+	glcd_set_overlays(overlayTables[overlayTable], overlayCount);
+}
+
+
+
+static void drawNewLine(void) {
+	glcd_draw_line(scene.lines[scene.lineCount - 1][0], scene.lines[scene.lineCount - 1][1], scene.lines[scene.lineCount - 1][2],
+		scene.lines[scene.lineCount - 1][3], BLACK);
+}
+
+
+
+static void drawNothing(void) {
+}
+
+
+
+/*The overlays in table order onto the background sent without them*/
+static bool sameAsComposite(void) {
+	static uint8_t plain[LCD_SIM_PAGES][GLCD_NUMBER_OF_COLS];
+	glcd_set_overlays(NULL, 0);
+	glcd_render_area(&wholeScreen, drawBackground);
+	memcpy(plain, lcdSim.ram, sizeof(plain));
+	//Back to the overlays for the next step
+	glcd_set_overlays(overlayTables[overlayTable], overlayCount);
+	glcd_render_area(&wholeScreen, drawBackground);
+
+	for (int y = 0; y < GLCD_LCD_HEIGHT; y++) {
+		for (int x = 0; x < GLCD_LCD_WIDTH; x++) {
+			bool pixel = plain[y / 8][x] >> (y % 8) & 1;
+			for (int i = 0; i < overlayCount; i++) {
+				const glcd_Overlay_t *overlay = &overlayTables[overlayTable][i];
+				if (!(overlay->phases >> overlayPhase & 1) || x < overlay->x || x >= overlay->x + overlay->w ||
+					y < overlay->y || y >= overlay->y + overlay->h) continue;
+				pixel = overlay->op == GLCD_OVERLAY_OR ? true : overlay->op == GLCD_OVERLAY_XOR ? !pixel : false;
+			}
+			if (pixel != (got[y / 8][x] >> (y % 8) & 1)) return false;
+		}
+	}
+	return true;
+}
+
+
+
+static void testOverlays(void) {
+	unsigned long steps = 0;
+	incrementalBytes = fullBytes = 0;
+	for (int c = 0; c < CASES; c++) {
+		randomScene();
+		glcd_render_area(&wholeScreen, drawBackground);
+
+		for (int s = 0; s < STEPS; s++) {
+			glcd_reset_bbox();
+			int change = rand() % 4;
+			if (change == 0 || rand() % 4 == 0) randomOverlays();
+			if (change == 1 || rand() % 4 == 0) {
+				overlayPhase = rand() % 8;
+				glcd_set_overlay_phase(overlayPhase);
+			}
+			if (change == 2) randomLine(scene.lines[scene.lineCount++]);
+			sendChanges(change == 2 ? drawNewLine : drawNothing, drawBackground);
+			CHECK(sameAsFull(drawBackground), "case %d step %d: %u overlays in phase %u differ from a full redraw", c, s,
+				overlayCount, overlayPhase);
+			CHECK(sameAsComposite(), "case %d step %d: %u overlays in phase %u differ from the composite", c, s, overlayCount,
+				overlayPhase);
+			steps++;
+		}
+	}
+	glcd_set_overlays(NULL, 0);
+	printf("overlays: %lu changes, %lu bytes sent against %lu for full redraws\n", steps, incrementalBytes, fullBytes);
+}
+
+
+
+int main(void) {
+	srand(1);
+	glcd_select_screen(glcd_buffer, &glcd_bbox);
+	testSegments();
+	testOverlays();
+	#if defined(GLCD_USE_STRIP_BUFFER)
+	return testResult("redrawtest(strip rendering)");
+	#else
+	return testResult("redrawtest(full frame buffer)");
+	#endif
+}
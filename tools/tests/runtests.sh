@@ -0,0 +1,52 @@
+#!/bin/bash
+
+# Build and run the host tests in tools/tests, each against the firmware sources it covers. Every test prints what
+# it measured and ends with "ok" or "FAILED"; the script exits with an error if any of them failed.
+# Give test names(e.g. memtest) to run only those.
+cd "$(dirname "$0")/../.."
+
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+failed=""
+
+# test name, then the gcc arguments besides the test itself
+run() {
+	local name=$1
+	shift
+	if [ -n "$only" ] && [[ " $only " != *" $name "* ]]; then return; fi
+	if gcc -O1 -Wall -Wextra -I. -Ilcd -I"$work" -o "$work/$name" "tools/tests/$name.c" "$@" && "$work/$name"; then return; fi
+	failed="$failed $name"
+}
+only="$*"
+
+#memset(), memcpy() and memmove() live in ch32v003fun.c with the rest of the runtime, take out just them
+sed -n -e '/^\/\* Word-at-a-time helpers/,/^}/p' -e '/^void \*memcpy(/,/^}/p' -e '/^void \*memmove(/,/^}/p' \
+	ch32v003fun/ch32v003fun.c > "$work/memfun.c"
+run memtest -fno-builtin
+run drawtest lcd/graphics.c lcd/glcd.c
+run drawtest lcd/graphics.c lcd/glcd.c -DGLCD_USE_STRIP_BUFFER
+run numbertest lcd/graphics.c lcd/glcd.c
+run redrawtest lcd/graphics.c lcd/glcd.c lcd/segments.c lcd/text.c lcd/overlay.c
+run redrawtest lcd/graphics.c lcd/glcd.c lcd/segments.c lcd/text.c lcd/overlay.c -DGLCD_USE_STRIP_BUFFER
+run speedhistorytest
+#The speed chart screen with the full frame buffer, the strip buffer and the prerendered backgrounds of the firmware build
+screens="src/speedHistory.c lcd/visuals.c lcd/widgets.c lcd/graphics.c lcd/graphs.c lcd/segments.c lcd/overlay.c lcd/text.c lcd/text_tiny.c lcd/glcd.c lcd/pkedLogo.c"
+run charttest $screens
+run charttest $screens -DGLCD_USE_STRIP_BUFFER
+run charttest $screens -DGLCD_USE_STRIP_BUFFER -DUSE_PRERENDERED_BACKGROUNDS
+run logboottest
+run logendurancetest
+run logreplaytest
+run brownouttest
+run pulselosstest -no-pie
+run joblogtest
+#The one storage suite against each backend
+run storagetest
+run storagetest -DUSE_EXTERNAL_FLASH
+run storagetest -DUSE_EXTERNAL_FLASH -DEXTERNAL_STORAGE_FRAM
+
+if [ -n "$failed" ]; then
+	echo "Failed:$failed"
+	exit 1
+fi
+echo "All passed"
@@ -0,0 +1,71 @@
+/*
+ * src/speedHistory.c against a brute-force reference: every slot of every tier and the job statistics are
+ * recomputed from all the 1s samples so far, after every sample. Random speeds, backwards and over 255 included,
+ * long enough for every ring to wrap many times, with job restarts now and then.
+ */
+#include "tools/tests/hosttest.h"
+#include "src/speedHistory.c"
+
+#define SAMPLES 20000
+
+static uint8_t raw[SAMPLES];
+static const uint8_t samplesPerSlot[SPEED_HISTORY_TIERS] = {1, SAMPLES_PER_10S_SLOT, SAMPLES_PER_10S_SLOT * SLOTS_PER_1MIN_SLOT};
+
+
+
+static void reference(uint32_t from, uint32_t length, speedSample_t *sample) {
+	uint32_t sum = 0;
+	sample->min = 255;
+	sample->max = 0;
+	for (uint32_t i = from; i < from + length; i++) {
+		if (raw[i] < sample->min) sample->min = raw[i];
+		if (raw[i] > sample->max) sample->max = raw[i];
+		sum += raw[i];
+	}
+	sample->avg = (sum + length / 2) / length;
+}
+
+
+
+static bool sameSample(const speedSample_t *a, const speedSample_t *b) {
+	return a->min == b->min && a->max == b->max && a->avg == b->avg;
+}
+
+
+
+int main(void) {
+	srand(1);
+	uint32_t jobStart = 0;
+	for (uint32_t n = 0; n < SAMPLES; ) {
+		int16_t speed = (rand() % 5) ? rand() % 400 - 60 : rand() % 30;
+		speedHistoryAdd(speed);
+		raw[n++] = (speed < 0) ? 0 : (speed > 255) ? 255 : speed;
+		if (rand() % 3000 == 0) {
+			speedHistoryResetJob();
+			jobStart = n;
+		}
+
+		for (speedTier_e tier = 0; tier < SPEED_HISTORY_TIERS; tier++) {
+			//Complete slots only, the newest first, as many as the ring holds
+			uint32_t complete = n / samplesPerSlot[tier];
+			uint32_t kept = (complete < tierSize[tier]) ? complete : tierSize[tier];
+			speedSample_t got, want;
+			for (uint32_t age = 0; age < kept; age++) {
+				reference((complete - 1 - age) * samplesPerSlot[tier], samplesPerSlot[tier], &want);
+				CHECK(speedHistoryGet(tier, age, &got) && sameSample(&got, &want),
+					"tier %d age %u after %u samples: %u/%u/%u, want %u/%u/%u", tier, age, n,
+					got.min, got.max, got.avg, want.min, want.max, want.avg);
+			}
+			CHECK(!speedHistoryGet(tier, kept, &got), "tier %d has more than %u slots after %u samples", tier, kept, n);
+		}
+
+		speedSample_t got, want = {0, 0, 0};
+		uint32_t samples = speedHistoryGetJobStats(&got);
+		if (samples) reference(jobStart, samples, &want);
+		CHECK(samples == n - jobStart && sameSample(&got, &want), "job statistics after %u samples", n);
+	}
+	printf("%u samples, every slot checked after each; history takes %zu bytes of RAM of %u\n", SAMPLES, sizeof(speedHistory),
+		SPEED_HISTORY_RAM_BUDGET);
+	CHECK(sizeof(speedHistory) <= SPEED_HISTORY_RAM_BUDGET, "history over its RAM budget");
+	return testResult("speedhistorytest");
+}
@@ -0,0 +1,307 @@
+/*
+ * One suite for the storage backends of include/storage.h, through src/mileageLog.c: the internal flash log by
+ * default, an EEPROM with -DUSE_EXTERNAL_FLASH and an FRAM with -DEXTERNAL_STORAGE_FRAM as well. runtests.sh builds
+ * it all three ways.
+ *
+ * Saves and brown-out saves in random order, some cut short by a power cut, a boot after each: the new mileage or
+ * the last one that made it. Warm restarts from the .noinit copy carry on without losing a save. A corrupted newest
+ * record gives the one before it. Then the checkpoint limits. The external memory is an I2C mock: an EEPROM NAKs
+ * while it writes a page, so no write may go out before the ACK polling sees it done. A missing chip boots a fresh
+ * machine and the saves give up instead of hanging.
+ */
+#include "tools/tests/hosttest.h"
+#include "tools/tests/flashsim.h"
+
+#if defined(USE_EXTERNAL_FLASH)
+#include "src/storageI2c.c"
+
+#define MEMORY_SIZE 8192u
+
+static uint8_t memory[MEMORY_SIZE];
+static uint16_t memoryPointer;
+static unsigned long slotWrites[EXTERNAL_STORAGE_SLOTS];
+static bool absent;
+static uint8_t busy; //Addressings the EEPROM still NAKs, writing the last page
+static unsigned long polls, lostWrites;
+
+
+
+static void writeMemory(const uint8_t *data, uint8_t length, bool torn) {
+	//A write wraps around within its page
+	uint16_t page = memoryPointer - memoryPointer % EXTERNAL_STORAGE_PAGE_SIZE;
+	#if defined(EXTERNAL_STORAGE_FRAM)
+	//Byte by byte, a cut stops it part way
+	uint8_t written = torn ? rand() % length : length;
+	#else
+	uint8_t written = length;
+	#endif
+	for (uint8_t i = 0; i < written; i++) {
+		uint8_t byte = data[i];
+		#if !defined(EXTERNAL_STORAGE_FRAM)
+		//The page cycle cut short leaves some bytes programmed and some not
+		if (torn && (rand() & 1)) byte = rand();
+		#endif
+		memory[page + (memoryPointer - page + i) % EXTERNAL_STORAGE_PAGE_SIZE] = byte;
+	}
+	if (page / EXTERNAL_STORAGE_PAGE_SIZE < EXTERNAL_STORAGE_SLOTS) slotWrites[page / EXTERNAL_STORAGE_PAGE_SIZE]++;
+}
+
+
+
+bool i2cReadOrWrite(uint8_t addr, uint8_t *data, uint8_t sz, bool rw) {
+	if (absent || (addr & 0xF8) != EXTERNAL_STORAGE_I2C_ADDR) return ERROR;
+	if (sz == 0 && rw == WRITE) {
+		//ACK polling
+		polls++;
+		if (busy) {
+			busy--;
+			return ERROR;
+		}
+		return OK;
+	}
+	if (busy) {
+		if (rw == WRITE) lostWrites++;
+		return ERROR;
+	}
+	if (rw == READ) {
+		for (uint8_t i = 0; i < sz; i++) data[i] = memory[memoryPointer++ % MEMORY_SIZE];
+		return OK;
+	}
+
+	#if EXTERNAL_STORAGE_ADDRESS_BYTES == 1
+	memoryPointer = (addr & 0x07) << 8 | data[0];
+	#else
+	memoryPointer = (data[0] << 8 | data[1]) % MEMORY_SIZE;
+	#endif
+	if (sz == EXTERNAL_STORAGE_ADDRESS_BYTES) return OK;
+	bool torn = flashSimTorn();
+	writeMemory(data + EXTERNAL_STORAGE_ADDRESS_BYTES, sz - EXTERNAL_STORAGE_ADDRESS_BYTES, torn);
+	if (torn) longjmp(flashSimCut, 1);
+	#if !defined(EXTERNAL_STORAGE_FRAM)
+	busy = 3;
+	#endif
+	return OK;
+}
+
+
+
+static void blank(void) {
+	memset(memory, 0xFF, sizeof(memory));
+}
+
+
+
+static uint16_t writeHead(void) {
+	return head;
+}
+
+
+
+static void corruptNewest(uint16_t headBefore) {
+	memory[slotAddress(headBefore) + 6] ^= 1;
+}
+
+
+
+static void forgetState(void) {
+	head = 0;
+	nextSequence = 0;
+	busy = 0;
+}
+
+#else
+#include "src/storageFlash.c"
+
+
+
+static void blank(void) {
+	memset((void *)FLASH_ADDR_TO_STORE_BACKUP_DATA, 0xFF, NON_VOLATILE_FLASH_DATA_STORAGE_SIZE);
+}
+
+
+
+static uint16_t writeHead(void) {
+	return writeOffset;
+}
+
+
+
+/*A snapshot if the save opened a page, else the delta at the head from before it*/
+static void corruptNewest(uint16_t headBefore) {
+	if (writeOffset % FLASH_PAGE_SIZE == SNAPSHOT_SIZE) ((uint8_t *)areaAddress(writeOffset - SNAPSHOT_SIZE))[4] ^= 1;
+	else ((uint8_t *)areaAddress(headBefore))[1] ^= 1;
+}
+
+
+
+static void forgetState(void) {
+	memset(&snapshot, 0, sizeof(snapshot));
+	writeOffset = 0;
+	nextSequence = 0;
+}
+#endif
+
+#include "src/mileageLog.c"
+
+machineData_t machineData;
+mileageData_t mileageData;
+
+
+
+/*Everything in RAM gone, as after a power cut*/
+static void forgetRam(void) {
+	memset(&machineData, 0, sizeof(machineData));
+	memset(&mileageData, 0, sizeof(mileageData));
+	forgetState();
+	savedMileage = 0;
+	savedOnTime = 0;
+}
+
+
+
+static void boot(void) {
+	forgetRam();
+	getSavedMileageDataFromFlash();
+}
+
+
+
+static void setMileage(const mileageData_t *data) {
+	mileageData = *data;
+	machineData.machine.currentDistance = data->currentDistance;
+	machineData.machine.time = data->currentTime;
+}
+
+
+
+static bool same(const mileageData_t *a, const mileageData_t *b) {
+	return !memcmp(a, b, sizeof(*a));
+}
+
+
+
+static void testSaves(void) {
+	boot();
+	CHECK(mileageData.machineMileage == 0 && mileageData.serviceOverdue == MACHINE_SERVICE_INTERVALS, "blank storage is not a fresh machine");
+	mileageData_t saved = mileageData;
+	unsigned long cuts = 0, warmRestarts = 0;
+
+	for (int i = 0; i < 20000; i++) {
+		mileageData_t data = saved;
+		uint32_t distance = (rand() % 50) ? rand() % 300 : rand() % 200000;
+		data.machineMileage += distance;
+		data.serviceOverdue -= distance;
+		data.currentDistance = (rand() % 40) ? data.currentDistance + distance : 0;
+		uint16_t minutes = rand() % 5;
+		data.currentTime += minutes;
+		data.machineOnTimeAge += minutes;
+		setMileage(&data);
+
+		flashSimCutAfter((rand() % 10 == 0) ? rand() % 3 : -1);
+		if (setjmp(flashSimCut)) {
+			cuts++;
+		} else if (rand() % 15 == 0) {
+			saveMachineMileageDataOnBrownOut();
+		} else {
+			saveMachineMileageDataToFlash();
+		}
+		flashSimCutAfter(-1);
+
+		if (rand() % 7 == 0) {
+			//Watchdog reset: the RAM copy comes back as it was, and the next save must not go over a good record
+			mileageLogSealWarmState();
+			mileageData_t before = mileageData;
+			forgetRam();
+			hostRcc.RSTSCKR = RCC_IWDGRSTF;
+			CHECK(restoreMileageDataFromRam() && same(&mileageData, &before), "warm restart %d", i);
+			saveMachineMileageDataToFlash();
+			data = mileageData;
+			warmRestarts++;
+		}
+
+		boot();
+		CHECK(same(&mileageData, &data) || same(&mileageData, &saved), "save %d: mileage %u, want %u or %u", i,
+			mileageData.machineMileage, data.machineMileage, saved.machineMileage);
+		CHECK(machineData.machine.currentDistance == mileageData.currentDistance && machineData.machine.time == mileageData.currentTime,
+			"save %d: job counters", i);
+		saved = mileageData;
+	}
+	printf("20000 saves, %lu cut short, %lu warm restarts\n", cuts, warmRestarts);
+}
+
+
+
+static void testCorruption(void) {
+	mileageData.machineMileage = 111;
+	saveMachineMileageDataToFlash();
+	uint16_t head = writeHead();
+	mileageData.machineMileage = 222;
+	saveMachineMileageDataToFlash();
+	boot();
+	CHECK(mileageData.machineMileage == 222, "newest record lost");
+	corruptNewest(head);
+	boot();
+	CHECK(mileageData.machineMileage == 111, "corrupted newest record: mileage %u, want 111", mileageData.machineMileage);
+}
+
+
+
+static void testCheckpoints(void) {
+	saveMachineMileageDataToFlash();
+	CHECK(!mileageLogCheckpointDue(), "checkpoint due right after a save");
+	mileageData.machineMileage += COUNTER_STEP;
+	bool onPulse = mileageLogCheckpointDue();
+	mileageData.machineMileage -= COUNTER_STEP;
+	mileageData.machineOnTimeAge++;
+	bool onMinute = mileageLogCheckpointDue();
+	mileageData.machineOnTimeAge--;
+	printf("checkpoints every %u m or %u min; due after a wheel pulse %d, after a minute %d\n", (unsigned)CHECKPOINT_DISTANCE,
+		(unsigned)CHECKPOINT_TIME, onPulse, onMinute);
+	#if defined(STORAGE_UNLIMITED_ENDURANCE)
+	CHECK(onPulse && onMinute, "unlimited endurance, every change is due");
+	#else
+	CHECK(!onPulse, "due after a single pulse");
+	mileageData.machineMileage += CHECKPOINT_DISTANCE * 10u - 1;
+	CHECK(!mileageLogCheckpointDue(), "due short of CHECKPOINT_DISTANCE");
+	mileageData.machineMileage++;
+	CHECK(mileageLogCheckpointDue(), "not due at CHECKPOINT_DISTANCE");
+	#endif
+}
+
+
+
+int main(void) {
+	#if !defined(USE_EXTERNAL_FLASH)
+	hostFlashMap();
+	#endif
+	srand(1);
+	blank();
+	testSaves();
+	testCorruption();
+	testCheckpoints();
+
+	#if defined(USE_EXTERNAL_FLASH)
+	unsigned long most = 0, least = ~0ul;
+	for (uint8_t s = 0; s < EXTERNAL_STORAGE_SLOTS; s++) {
+		if (slotWrites[s] > most) most = slotWrites[s];
+		if (slotWrites[s] < least) least = slotWrites[s];
+	}
+	printf("%lu ACK polls, %lu writes lost to a busy memory, %lu..%lu writes a slot, wear %u%%\n", polls, lostWrites, least,
+		most, mileageLogStats.wear);
+	CHECK(!lostWrites, "%lu writes went out while the memory was busy", lostWrites);
+
+	absent = true;
+	boot();
+	CHECK(mileageData.machineMileage == 0, "a missing chip did not boot a fresh machine");
+	saveMachineMileageDataToFlash();
+	absent = false;
+	#endif
+
+	#if !defined(USE_EXTERNAL_FLASH)
+	return testResult("storagetest(internal flash)");
+	#elif defined(EXTERNAL_STORAGE_FRAM)
+	return testResult("storagetest(FRAM)");
+	#else
+	return testResult("storagetest(EEPROM)");
+	#endif
+}